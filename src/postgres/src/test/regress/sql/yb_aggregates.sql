@@ -129,3 +129,14 @@ EXPLAIN (COSTS OFF) SELECT COUNT(*), SUM(int_4) FROM ybaggtest;
 EXPLAIN (COSTS OFF) SELECT int_2, COUNT(*), SUM(int_4) FROM ybaggtest GROUP BY int_2;
 EXPLAIN (COSTS OFF) SELECT DISTINCT int_4 FROM ybaggtest;
 EXPLAIN (COSTS OFF) SELECT COUNT(distinct int_4), SUM(int_4) FROM ybaggtest;
+
+-- Verify pushed down COUNT(*) and COUNT(constant), which are computed from the number of rows.
+CREATE TABLE ybcounttest(k INT PRIMARY KEY, v INT);
+INSERT INTO ybcounttest SELECT i, CASE WHEN i % 3 = 0 THEN NULL ELSE i END FROM generate_series(1, 10) i;
+SELECT COUNT(*), COUNT(0), COUNT(v), SUM(v) FROM ybcounttest;
+-- Filtered scan.
+SELECT COUNT(*), COUNT(0), COUNT(v), SUM(v) FROM ybcounttest WHERE k > 4;
+SELECT COUNT(*), COUNT(0) FROM ybcounttest WHERE v IS NULL;
+-- Empty result.
+SELECT COUNT(*), COUNT(0) FROM ybcounttest WHERE k > 100;
+DROP TABLE ybcounttest;
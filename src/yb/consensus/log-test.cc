@@ -67,6 +67,7 @@ DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_abrupt_server_restart);
 DECLARE_bool(TEST_skip_file_close);
 DECLARE_int64(reuse_unclosed_segment_threshold);
+DECLARE_int32(log_compression_algo);
 
 namespace yb {
 namespace log {
@@ -350,6 +351,56 @@ TEST_F(LogTest, TestMultipleEntriesInABatch) {
   ASSERT_OK(log_->Close());
 }
 
+// Writes the same entries to a segment with compression and to a segment without it, and checks
+// that both are read back.
+TEST_F(LogTest, CompressedEntryBatches) {
+  constexpr int kEntriesPerSegment = 100;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_compression_algo) = LOG_COMPRESSION_LZ4;
+  BuildLog();
+
+  OpIdPB opid;
+  opid.set_term(1);
+  opid.set_index(1);
+
+  ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, kEntriesPerSegment - 1));
+  // Single entry batch is too small to be compressed, so it is stored as is.
+  ASSERT_OK(AppendNoOpToLogSync(clock_, log_.get(), &opid));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_compression_algo) = LOG_COMPRESSION_NONE;
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+  ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, kEntriesPerSegment - 1));
+  ASSERT_OK(AppendNoOpToLogSync(clock_, log_.get(), &opid));
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  std::vector<LogCompressionTypePB> compression_types;
+  std::vector<uint64_t> file_sizes;
+  int64_t expected_index = 1;
+  for (const auto& segment : segments) {
+    auto read_entries = segment->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    if (read_entries.entries.empty()) {
+      continue;
+    }
+    ASSERT_EQ(read_entries.entries.size(), implicit_cast<size_t>(kEntriesPerSegment));
+    for (const auto& entry : read_entries.entries) {
+      ASSERT_EQ(entry->replicate().id().index(), expected_index);
+      ++expected_index;
+    }
+    compression_types.push_back(segment->header().compression_type());
+    file_sizes.push_back(segment->file_size());
+  }
+  ASSERT_EQ(compression_types,
+            (std::vector<LogCompressionTypePB>{LOG_COMPRESSION_LZ4, LOG_COMPRESSION_NONE}));
+  LOG(INFO) << "Segment sizes: " << AsString(file_sizes);
+  ASSERT_LT(file_sizes[0], file_sizes[1]);
+
+  ASSERT_OK(log_->Close());
+}
+
 // Tests that everything works properly with fsync enabled:
 // This also tests SyncDir() (see KUDU-261), which is called whenever
 // a new log segment is initialized.
@@ -444,6 +495,44 @@ TEST_F(LogTest, TestFsyncDataSize) {
   LOG(INFO)<< "Wrote " << size << " batches to log";
 }
 
+// Tests that a background sync task queued before a segment rollover syncs the entries appended
+// to the new segment.
+TEST_F(LogTest, BackgroundSyncAfterRollOver) {
+  options_.durable_wal_write = false;
+  // Don't let Log::Sync sync or queue a sync task by itself.
+  options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(100000);
+  options_.bytes_durable_wal_write_mb = 0;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+
+  OpIdPB opid = MakeOpId(1, 1);
+  ASSERT_OK(AppendNoOp(&opid));
+
+  // Emulate a sync task that was queued for the current segment.
+  const auto segment_sequence_number = log_->active_segment_sequence_number_.load();
+  log_->fsync_task_in_queue_ = true;
+
+  // The entry that triggers the rollover is appended to the new segment.
+  while (log_->active_segment_sequence_number_.load() == segment_sequence_number) {
+    ASSERT_OK(AppendNoOp(&opid));
+  }
+  ASSERT_TRUE(log_->periodic_sync_needed_.load());
+
+  auto num_syncs = log_->metrics_->sync_latency->TotalCount();
+  log_->DoSyncAndResetTaskInQueue(segment_sequence_number);
+  ASSERT_FALSE(log_->fsync_task_in_queue_.load());
+  ASSERT_FALSE(log_->periodic_sync_needed_.load());
+  ASSERT_EQ(log_->metrics_->sync_latency->TotalCount(), num_syncs + 1);
+
+  // Nothing was appended since the last sync, so the task for the old segment is skipped.
+  log_->fsync_task_in_queue_ = true;
+  log_->DoSyncAndResetTaskInQueue(segment_sequence_number);
+  ASSERT_FALSE(log_->fsync_task_in_queue_.load());
+  ASSERT_EQ(log_->metrics_->sync_latency->TotalCount(), num_syncs + 1);
+
+  ASSERT_OK(log_->Close());
+}
+
 // Regression test for part of KUDU-735:
 // if a log is not preallocated, we should properly track its on-disk size as we append to
 // it.
@@ -213,6 +213,11 @@ DEFINE_UNKNOWN_int64(reuse_unclosed_segment_threshold, -1,
             "Otherwise, Log will create a new segment. If the value is negative, it means"
             "reuse unclosed segment feature is disabled");
 
+DEFINE_RUNTIME_int32(log_compression_algo, 0,
+    "Algorithm used to compress entry batches of new WAL segments. 0 - no compression, "
+    "1 - lz4. Segments written with compression can't be read by versions that don't support "
+    "it, so it should only be enabled after all nodes are upgraded.");
+
 // Validate that log_min_segments_to_retain >= 1
 static bool ValidateLogsToRetain(const char* flagname, int value) {
   if (value >= 1) {
@@ -1104,13 +1109,19 @@ Status Log::DoSync() {
 // Important to note that there is at most one task queued/running ::DoSyncAndResetTaskInQueue
 // at any given time.
 //
-// TODO: DoSyncAndResetTaskInQueue could perform one additional/unnecessary fsync operation when
-// segment rollover happens before the background task calls ::DoSync. In that case, the call to
-// ::DoSync operates on the new segment. We could use active_segment_sequence_number_ to determine
-// if we are operating on current/new segment and skip calling fsync whenever unnecessary. We will
-// have to use active_segment_sequence_number_ instead of fsync_task_in_queue_, in ::Sync(), to
-// determine if there is a pending fsync task corresponding to the current active segment.
-void Log::DoSyncAndResetTaskInQueue() {
+// When segment rollover happens before the background task is executed, the data appended before
+// the rollover was already synced by ::RollOver. If nothing was appended to the new segment since
+// then, the task does not call ::DoSync, avoiding one additional fsync of the new segment.
+// Otherwise the task still syncs: while it is queued, ::Sync leaves the fsync of new appends to it,
+// and on an idle tablet there may be no following call to ::Sync.
+void Log::DoSyncAndResetTaskInQueue(uint64_t segment_sequence_number) {
+  if (active_segment_sequence_number_.load(std::memory_order_acquire) != segment_sequence_number &&
+      !periodic_sync_needed_.load(std::memory_order_acquire)) {
+    VLOG_WITH_PREFIX(2) << "Skip background sync of rolled over segment "
+                        << segment_sequence_number;
+    fsync_task_in_queue_.store(false, std::memory_order_release);
+    return;
+  }
   auto status = DoSync();
   if (!status.ok()) {
     // ensure that fsync gets called on the subsequent call to Log::Sync() function
@@ -1223,7 +1234,8 @@ Status Log::Sync() {
       }
       fsync_task_in_queue_.store(true, std::memory_order_release);
       auto status = background_sync_threadpool_token_->SubmitFunc(
-          std::bind(&Log::DoSyncAndResetTaskInQueue, this));
+          std::bind(&Log::DoSyncAndResetTaskInQueue, this,
+                    active_segment_sequence_number_.load(std::memory_order_acquire)));
       if (!status.ok()) {
         LOG_WITH_PREFIX(WARNING) << "Pushing sync operation to log-sync queue failed with "
                                  << "status " << status;
@@ -1827,6 +1839,14 @@ Status Log::SwitchToAllocatedSegment() {
   header.set_minor_version(kLogMinorVersion);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_unused_tablet_id(tablet_id_);
+  auto compression_algo = FLAGS_log_compression_algo;
+  if (compression_algo != LOG_COMPRESSION_NONE) {
+    if (LogCompressionTypePB_IsValid(compression_algo)) {
+      header.set_compression_type(static_cast<LogCompressionTypePB>(compression_algo));
+    } else {
+      YB_LOG_EVERY_N_SECS(DFATAL, 5) << "Unknown WAL compression algorithm: " << compression_algo;
+    }
+  }
 
   // Set up the new footer. This will be maintained as the segment is written.
   footer_builder_.Clear();
@@ -335,6 +335,7 @@ class Log : public RefCountedThreadSafe<Log> {
   FRIEND_TEST(LogTest, TestReadLogWithReplacedReplicates);
   FRIEND_TEST(LogTest, TestWriteAndReadToAndFromInProgressSegment);
   FRIEND_TEST(LogTest, TestLogMetrics);
+  FRIEND_TEST(LogTest, BackgroundSyncAfterRollOver);
 
   FRIEND_TEST(cdc::CDCServiceTestMaxRentionTime, TestLogRetentionByOpId_MaxRentionTime);
   FRIEND_TEST(cdc::CDCServiceTestMinSpace, TestLogRetentionByOpId_MinSpace);
@@ -432,7 +433,10 @@ class Log : public RefCountedThreadSafe<Log> {
   Status DoSync() EXCLUDES(active_segment_mutex_);
 
   // Calls ::DoSync and resets fsync_task_in_queue_.
-  void DoSyncAndResetTaskInQueue() EXCLUDES(active_segment_mutex_);
+  // Sync is skipped when the segment with segment_sequence_number was already rolled over and
+  // nothing was appended since then, since RollOver syncs the segment before closing it.
+  void DoSyncAndResetTaskInQueue(uint64_t segment_sequence_number)
+      EXCLUDES(active_segment_mutex_);
 
   Status Sync() EXCLUDES(active_segment_mutex_);
 
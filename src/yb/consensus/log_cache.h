@@ -197,6 +197,11 @@ class LogCache {
     // to compute, so we compute it only once upon insertion.
     size_t mem_usage = 0;
 
+    // The cached size of msg on the wire as a part of consensus update request. Messages in the
+    // cache are not modified, so it is computed once upon insertion instead of on each read for
+    // every peer.
+    int64_t wire_size = 0;
+
     // Did we start memory tracking for this entry.
     bool tracked = false;
   };
@@ -38,6 +38,7 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
 
 #include "yb/common/hybrid_time.h"
 
@@ -149,6 +150,52 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 
 const size_t kEntryHeaderSize = 12;
 
+namespace {
+
+// Codec of a single entry batch in a segment with compression. Stored as the first byte of the
+// batch data.
+enum class EntryBatchCodec : uint8_t {
+  kNone = 0,
+  kLZ4 = 1,
+};
+
+// Codec byte followed by the fixed32 uncompressed size.
+constexpr size_t kLZ4EntryBatchPrefixSize = 5;
+
+// Decodes the entry batch data of a segment with compression. Decompressed data is stored to
+// buffer, that should outlive the returned slice.
+Result<Slice> DecompressEntryBatch(Slice data, RefCntBuffer* buffer) {
+  if (data.empty()) {
+    return STATUS(Corruption, "Missing entry batch codec");
+  }
+  auto codec = static_cast<EntryBatchCodec>(data.consume_byte());
+  switch (codec) {
+    case EntryBatchCodec::kNone:
+      return data;
+    case EntryBatchCodec::kLZ4: {
+      if (data.size() < kLZ4EntryBatchPrefixSize - 1) {
+        return STATUS_FORMAT(Corruption, "Too short LZ4 entry batch: $0", data.size());
+      }
+      auto uncompressed_size = DecodeFixed32(data.data());
+      data.remove_prefix(kLZ4EntryBatchPrefixSize - 1);
+      RefCntBuffer uncompressed(uncompressed_size);
+      auto res = LZ4_decompress_safe(
+          data.cdata(), uncompressed.data(), narrow_cast<int>(data.size()),
+          narrow_cast<int>(uncompressed_size));
+      if (res < 0 || implicit_cast<size_t>(res) != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "LZ4 decompression failed: $0, expected size: $1", res,
+            uncompressed_size);
+      }
+      *buffer = std::move(uncompressed);
+      return buffer->AsSlice();
+    }
+  }
+  return STATUS_FORMAT(Corruption, "Unknown entry batch codec: $0", static_cast<int>(codec));
+}
+
+} // namespace
+
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
@@ -949,6 +996,14 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
                                          header.msg_crc, read_crc));
   }
 
+  auto batch_data = entry_batch_slice.Prefix(header.msg_length);
+  if (header_.compression_type() != LOG_COMPRESSION_NONE) {
+    batch_data = VERIFY_RESULT_PREPEND(
+        DecompressEntryBatch(batch_data, &buffer),
+        Format("Failed to decompress entry at offset: $0, length: $1",
+               *offset, header.msg_length));
+  }
+
   // TODO(lw_uc) embed buffer and first arena block into holder itself.
   struct DataHolder {
     RefCntBuffer buffer;
@@ -959,7 +1014,7 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
 
   auto holder = std::make_shared<DataHolder>(buffer);
   auto batch = holder->arena.NewArenaObject<LWLogEntryBatchPB>();
-  s = batch->ParseFromSlice(entry_batch_slice.Prefix(header.msg_length));
+  s = batch->ParseFromSlice(batch_data);
 
   if (!s.ok()) {
     return STATUS_FORMAT(
@@ -1112,31 +1167,60 @@ Status WritableLogSegment::WriteIndexWithFooterAndClose(
   return Status::OK();
 }
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
   uint8_t header_buf[kEntryHeaderSize];
 
+  // In a segment with compression the batch is prefixed by its codec, and by the uncompressed
+  // size for LZ4.
+  uint8_t prefix_buf[kLZ4EntryBatchPrefixSize];
+  Slice prefix;
+  Slice data = entry_batch_data;
+  if (header_.compression_type() != LOG_COMPRESSION_NONE) {
+    DCHECK_EQ(header_.compression_type(), LOG_COMPRESSION_LZ4);
+    auto bound = LZ4_compressBound(narrow_cast<int>(data.size()));
+    compression_buffer_.resize(bound);
+    auto compressed_size = LZ4_compress_default(
+        data.cdata(), pointer_cast<char*>(compression_buffer_.data()),
+        narrow_cast<int>(data.size()), bound);
+    // Store the batch as is, when compression does not save space.
+    if (compressed_size > 0 &&
+        implicit_cast<size_t>(compressed_size) + kLZ4EntryBatchPrefixSize < data.size() + 1) {
+      prefix_buf[0] = static_cast<uint8_t>(EntryBatchCodec::kLZ4);
+      InlineEncodeFixed32(&prefix_buf[1], narrow_cast<uint32_t>(data.size()));
+      prefix = Slice(prefix_buf, kLZ4EntryBatchPrefixSize);
+      data = Slice(compression_buffer_.data(), compressed_size);
+    } else {
+      prefix_buf[0] = static_cast<uint8_t>(EntryBatchCodec::kNone);
+      prefix = Slice(prefix_buf, 1);
+    }
+  }
+
   // First encode the length of the message.
-  auto len = data.size();
+  auto len = prefix.size() + data.size();
   InlineEncodeFixed32(&header_buf[0], narrow_cast<uint32_t>(len));
 
   // Then the CRC of the message.
-  uint32_t msg_crc = crc::Crc32c(data.data(), data.size());
-  InlineEncodeFixed32(&header_buf[4], msg_crc);
+  uint64_t msg_crc = 0;
+  auto* crc32c = crc::GetCrc32cInstance();
+  crc32c->Compute(prefix.data(), prefix.size(), &msg_crc);
+  crc32c->Compute(data.data(), data.size(), &msg_crc);
+  InlineEncodeFixed32(&header_buf[4], static_cast<uint32_t>(msg_crc));
 
   // Then the CRC of the header
   uint32_t header_crc = crc::Crc32c(&header_buf, 8);
   InlineEncodeFixed32(&header_buf[8], header_crc);
 
-  std::array<Slice, 2> slices = {
+  std::array<Slice, 3> slices = {
       Slice(header_buf, sizeof(header_buf)),
-      Slice(data),
+      prefix,
+      data,
   };
 
   // Write the header to the file, followed by the batch data itself.
   RETURN_NOT_OK(writable_file_->AppendSlices(slices.data(), slices.size()));
-  written_offset_ += sizeof(header_buf) + data.size();
+  written_offset_ += sizeof(header_buf) + len;
 
   return Status::OK();
 }
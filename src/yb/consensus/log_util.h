@@ -434,6 +434,7 @@ class WritableLogSegment {
   // Appends the provided batch of data, including a header
   // and checksum.
   // Makes sure that the log segment has not been closed.
+  // The batch is compressed when the segment header has compression_type set.
   Status WriteEntryBatch(const Slice& entry_batch_data);
 
   // Makes sure the I/O buffers in the underlying writable file are flushed.
@@ -508,6 +509,9 @@ class WritableLogSegment {
 
   faststring index_block_header_buffer_;
 
+  // Buffer for compressed entry batch, reused between batches.
+  faststring compression_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
@@ -49,6 +49,10 @@ namespace {
 
 constexpr int64_t kNothingFound = -1;
 
+// Special index used for liveness column, that does not have value in packed row, but is
+// present when row is packed.
+constexpr int64_t kLivenessColumnIdx = -2;
+
 YB_STRONGLY_TYPED_BOOL(CheckExistOnly);
 
 // Shared information about packed row. I.e. common for all columns in this row.
@@ -199,6 +203,28 @@ DocDBTableReader::DocDBTableReader(
       << "Projection: " << AsString(projection_) << ", read time: " << iter_->read_time();
 }
 
+const std::vector<int64_t>& DocDBTableReader::PackedProjectionIndexes(
+    const SchemaPacking& schema_packing) {
+  if (packed_projection_schema_packing_ == &schema_packing) {
+    return packed_projection_indexes_;
+  }
+  packed_projection_schema_packing_ = &schema_packing;
+  packed_projection_indexes_.clear();
+  packed_projection_indexes_.reserve(projection_->size());
+  for (const auto& column : *projection_) {
+    if (!column.IsColumnId()) {
+      // Used in tests only.
+      packed_projection_indexes_.push_back(kSkippedColumnIdx);
+      continue;
+    }
+    auto column_id = column.GetColumnId();
+    packed_projection_indexes_.push_back(
+        column_id == KeyEntryValue::kLivenessColumn.GetColumnId()
+            ? kLivenessColumnIdx : schema_packing.GetIndex(column_id));
+  }
+  return packed_projection_indexes_;
+}
+
 void DocDBTableReader::SetTableTtl(const Schema& table_schema) {
   table_expiration_ = Expiration(TableTTL(table_schema));
 }
@@ -428,13 +454,11 @@ class DocDBTableReader::GetHelperBase {
   // Before calling, all fields should have correct values, especially column_index_ that points
   // to the current column in projection.
   void UpdatePackedColumnData() {
-    auto& column = (*reader_.projection_)[column_index_];
-    if (column.IsColumnId()) {
-      packed_column_data_ = GetPackedColumn(column.GetColumnId());
-    } else {
-      // Used in tests only.
+    if (!packed_projection_indexes_) {
       packed_column_data_.row = nullptr;
+      return;
     }
+    packed_column_data_ = GetPackedColumnByIndex((*packed_projection_indexes_)[column_index_]);
   }
 
   virtual Status SetRootValue(ValueEntryType row_value_type, const Slice& row_value) = 0;
@@ -464,6 +488,9 @@ class DocDBTableReader::GetHelperBase {
       packed_row_.Assign(value);
       packed_row_data_.doc_ht = doc_ht;
       packed_row_data_.control_fields = control_fields;
+      if (reader_.projection_) {
+        packed_projection_indexes_ = &reader_.PackedProjectionIndexes(*schema_packing_);
+      }
       *root_expiration = GetNewExpiration(*root_expiration, ValueControlFields::kMaxTtl, doc_ht);
     } else if (value_type != ValueEntryType::kTombstone && value_type != ValueEntryType::kInvalid) {
       // Used in tests only
@@ -482,7 +509,14 @@ class DocDBTableReader::GetHelperBase {
       return PackedColumnData();
     }
 
-    if (column_id == KeyEntryValue::kLivenessColumn.GetColumnId()) {
+    return GetPackedColumnByIndex(
+        column_id == KeyEntryValue::kLivenessColumn.GetColumnId()
+            ? kLivenessColumnIdx : schema_packing_->GetIndex(column_id));
+  }
+
+  // Returns packed data for column with specified index in schema packing.
+  PackedColumnData GetPackedColumnByIndex(int64_t packed_idx) {
+    if (packed_idx == kLivenessColumnIdx) {
       DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row for liveness column";
       return PackedColumnData {
         .row = &packed_row_data_,
@@ -491,17 +525,17 @@ class DocDBTableReader::GetHelperBase {
       };
     }
 
-    auto slice = schema_packing_->GetValue(column_id, packed_row_.AsSlice());
-    if (!slice) {
-      DVLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for " << column_id;
+    if (packed_idx == kSkippedColumnIdx) {
+      DVLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for column " << column_index_;
       return PackedColumnData();
     }
 
-    DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row " << column_id << ": "
-                                  << slice->ToDebugHexString();
+    auto slice = schema_packing_->GetValue(packed_idx, packed_row_.AsSlice());
+    DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row " << packed_idx << ": "
+                                  << slice.ToDebugHexString();
     return PackedColumnData {
       .row = &packed_row_data_,
-      .encoded_value = slice->empty() ? NullSlice() : *slice,
+      .encoded_value = slice.empty() ? NullSlice() : slice,
       .liveness_column = false,
     };
   }
@@ -544,6 +578,8 @@ class DocDBTableReader::GetHelperBase {
   ValueBuffer packed_row_;
   PackedRowData packed_row_data_;
   const SchemaPacking* schema_packing_ = nullptr;
+  // Indexes of projection columns in schema_packing_, nullptr if row is not packed.
+  const std::vector<int64_t>* packed_projection_indexes_ = nullptr;
 
   // If packed row is found, this field contains data related to currently scanned column.
   PackedColumnData packed_column_data_;
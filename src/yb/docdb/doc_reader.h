@@ -113,6 +113,11 @@ class DocDBTableReader {
   // at that row.
   Status InitForKey(const Slice& sub_doc_key);
 
+  // Returns indexes of projection columns in the specified schema packing.
+  // Result is cached for the last used packing, so rows with the same schema version don't
+  // perform per column lookups.
+  const std::vector<int64_t>& PackedProjectionIndexes(const SchemaPacking& schema_packing);
+
   class GetHelperBase;
   class GetHelper;
   class FlatGetHelper;
@@ -125,6 +130,11 @@ class DocDBTableReader {
   const SchemaPackingStorage& schema_packing_storage_;
 
   std::vector<KeyBytes> encoded_projection_;
+
+  // Schema packing that packed_projection_indexes_ were calculated for.
+  const SchemaPacking* packed_projection_schema_packing_ = nullptr;
+  std::vector<int64_t> packed_projection_indexes_;
+
   DocHybridTime table_tombstone_time_ = DocHybridTime::kMin;
   Expiration table_expiration_;
 };
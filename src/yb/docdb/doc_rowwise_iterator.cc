@@ -690,6 +690,8 @@ Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
 
   iter_key_.Clear();
   row_ready_ = false;
+  // The iterator could be done after the previous lookup, but it was repositioned by the seek.
+  done_ = false;
 
   return VERIFY_RESULT(HasNext()) && VERIFY_RESULT(GetTupleId()) == tuple_id;
 }
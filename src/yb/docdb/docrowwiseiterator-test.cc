@@ -169,6 +169,7 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void TestDocRowwiseIteratorWithRowDeletes();
   void TestBackfillInsert();
   void TestDocRowwiseIteratorHasNextIdempotence();
+  void TestSeekTupleAfterMissingTuple();
   void TestDocRowwiseIteratorIncompleteProjection();
   void TestColocatedTableTombstone();
   void TestDocRowwiseIteratorMultipleDeletes();
@@ -1119,6 +1120,34 @@ SubDocKey(DocKey([], ["row1", 11111]), [ColumnId(50); HT{ physical: 2800 }]) ->
   }
 }
 
+void DocRowwiseIteratorTest::TestSeekTupleAfterMissingTuple() {
+  SetupDocRowwiseIteratorData();
+
+  const KeyBytes encoded_missing_doc_key(DocKey(KeyEntryValues("row3", 33333)).Encode());
+
+  auto iter = ASSERT_RESULT(CreateIterator(
+      projection(), doc_read_context(), kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(5000)));
+
+  QLTableRow row;
+  QLValue value;
+
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTuple(kEncodedDocKey2)));
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(projection().column_id(1), &value));
+  ASSERT_EQ(30000, value.int64_value());
+
+  // The missing key is after all existing keys, so the iterator is exhausted after this lookup.
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTuple(encoded_missing_doc_key)));
+
+  // The same iterator should still be usable for the following lookups.
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTuple(kEncodedDocKey1)));
+  row.Clear();
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(projection().column_id(1), &value));
+  ASSERT_EQ(10000, value.int64_value());
+}
+
 void DocRowwiseIteratorTest::TestDocRowwiseIteratorIncompleteProjection() {
   auto dwb = MakeDocWriteBatch();
 
@@ -1930,6 +1959,10 @@ TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorHasNextIdempotence) {
   TestDocRowwiseIteratorHasNextIdempotence();
 }
 
+TEST_F(DocRowwiseIteratorTest, SeekTupleAfterMissingTuple) {
+  TestSeekTupleAfterMissingTuple();
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorIncompleteProjection) {
   TestDocRowwiseIteratorIncompleteProjection();
 }
@@ -61,6 +61,9 @@ void TestRowPacking(const Schema& schema, const std::vector<QLValuePB>& values)
   ASSERT_EQ(version, kVersion);
   for (size_t i = schema.num_key_columns(); i != schema.num_columns(); ++i) {
     auto value_slice = *schema_packing.GetValue(schema.column_id(i), packed);
+    auto packed_idx = schema_packing.GetIndex(schema.column_id(i));
+    ASSERT_GE(packed_idx, 0);
+    ASSERT_EQ(schema_packing.GetValue(packed_idx, packed), value_slice);
     const auto& value = values[i - schema.num_key_columns()];
     PrimitiveValue decoded_value;
     if (IsNull(value)) {
@@ -13,7 +13,10 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -116,6 +119,24 @@ bool ShouldYsqlPackRow(bool is_colocated) {
 
 namespace {
 
+constexpr size_t kRowsReorderBufferBlockSize = 4096;
+
+// Returns true if expression is COUNT of not null constant, i.e. COUNT(*).
+// Result of such aggregate does not depend on row content, so it is equal to the number of
+// aggregated rows.
+bool IsCountOfNotNullConstant(const PgsqlExpressionPB& expr) {
+  if (!expr.has_tscall()) {
+    return false;
+  }
+  const auto& tscall = expr.tscall();
+  if (static_cast<bfpg::TSOpcode>(tscall.opcode()) != bfpg::TSOpcode::kCount ||
+      tscall.operands().empty()) {
+    return false;
+  }
+  const auto& operand = *tscall.operands().begin();
+  return operand.has_value() && !IsNull(operand.value());
+}
+
 // Compatibility: accept column references from a legacy nodes as a list of column ids only
 // Return the next index after last key column referenced.
 Result<size_t> CreateProjection(const Schema& schema,
@@ -1494,45 +1515,73 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
   }
 
 
-  const auto &batch_args = request_.batch_arguments();
-  auto min_arg = batch_args.begin();
-  auto max_arg = batch_args.begin();
-  for(auto batch_arg_it = batch_args.begin() + 1;
-      batch_arg_it != batch_args.end(); batch_arg_it++) {
-    SCHECK(batch_arg_it->has_ybctid(), InternalError, "ybctid arguments can be batched only");
-    if (min_arg->ybctid().value() > batch_arg_it->ybctid().value()) {
-      min_arg = batch_arg_it;
-    } else if (max_arg->ybctid().value() < batch_arg_it->ybctid().value()) {
-      max_arg = batch_arg_it;
-    }
+  const auto& batch_args = request_.batch_arguments();
+  for (const auto& batch_arg : batch_args) {
+    SCHECK(batch_arg.has_ybctid(), InternalError, "ybctid arguments can be batched only");
   }
 
-  bool iter_valid = false;
-  for(const PgsqlBatchArgumentPB& batch_argument : batch_args) {
-    if (!iter_valid) {
-      // It can be the case like when there is a tablet split that we still want
-      // to continue seeking through all the given batch arguments even though one
-      // of them wasn't found. If it wasn't found, table_iter_ becomes invalid
-      // and we have to make a new iterator.
-      RETURN_NOT_OK(ql_storage.GetIterator(
-          request_.stmt_id(), projection, doc_read_context, txn_op_context_,
-          deadline, read_time, min_arg->ybctid().value(),
-          max_arg->ybctid().value(), &table_iter_));
+  // Look up ybctids in sorted order, so a single iterator moves only forward through the regular
+  // and intents DBs, and neighbouring keys share already loaded index and data blocks.
+  std::vector<int> lookup_order(batch_args.size());
+  std::iota(lookup_order.begin(), lookup_order.end(), 0);
+  auto ybctid = [&batch_args](int idx) -> const std::string& {
+    return batch_args[idx].ybctid().value().binary_value();
+  };
+  std::sort(lookup_order.begin(), lookup_order.end(), [&ybctid](int lhs, int rhs) {
+    return ybctid(lhs) < ybctid(rhs);
+  });
+
+  // Response rows should follow the order of batch arguments. When arguments are not sorted,
+  // found rows are written to a separate buffer and copied to the result in the argument order.
+  const bool reorder_rows = !std::is_sorted(lookup_order.begin(), lookup_order.end());
+  std::optional<WriteBuffer> lookup_buffer;
+  // Range of the row in lookup_buffer for each found batch argument.
+  std::vector<std::optional<std::pair<size_t, size_t>>> row_ranges;
+  if (reorder_rows) {
+    lookup_buffer.emplace(kRowsReorderBufferBlockSize);
+    row_ranges.resize(batch_args.size());
+  }
+  auto* rows_buffer = reorder_rows ? &*lookup_buffer : result_buffer;
+
+  RETURN_NOT_OK(ql_storage.GetIterator(
+      request_.stmt_id(), projection, doc_read_context, txn_op_context_,
+      deadline, read_time, batch_args[lookup_order.front()].ybctid().value(),
+      batch_args[lookup_order.back()].ybctid().value(), &table_iter_));
+
+  for (auto idx : lookup_order) {
+    // Get the row. A missing ybctid does not invalidate the iterator, since every SeekTuple
+    // repositions it.
+    if (!VERIFY_RESULT(table_iter_->SeekTuple(ybctid(idx)))) {
+      continue;
     }
-    // Get the row.
-    auto &tuple_id = batch_argument.ybctid().value();
-    iter_valid = VERIFY_RESULT(table_iter_->SeekTuple(tuple_id.binary_value()));
-    if (iter_valid) {
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
-      bool is_match = true;
-      RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
-      if (is_match) {
-        // Populate result set.
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-        response_.add_batch_orders(batch_argument.order());
-        row_count++;
+    row.Clear();
+    RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+    bool is_match = true;
+    RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
+    if (!is_match) {
+      continue;
+    }
+    // Populate result set.
+    const auto row_start = rows_buffer->size();
+    RETURN_NOT_OK(PopulateResultSet(row, rows_buffer));
+    if (reorder_rows) {
+      row_ranges[idx].emplace(row_start, rows_buffer->size());
+    } else {
+      response_.add_batch_orders(batch_args[idx].order());
+    }
+    row_count++;
+  }
+
+  if (reorder_rows && row_count) {
+    std::string rows_data;
+    lookup_buffer->AssignTo(&rows_data);
+    for (int idx = 0; idx != batch_args.size(); ++idx) {
+      const auto& range = row_ranges[idx];
+      if (!range) {
+        continue;
       }
+      result_buffer->Append(rows_data.data() + range->first, rows_data.data() + range->second);
+      response_.add_batch_orders(batch_args[idx].order());
     }
   }
 
@@ -1607,11 +1656,17 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
   if (aggr_result_.empty()) {
     int column_count = request_.targets().size();
     aggr_result_.resize(column_count);
+    for (int aggr_index = 0; aggr_index != column_count; ++aggr_index) {
+      if (!IsCountOfNotNullConstant(request_.targets(aggr_index))) {
+        evaluated_aggr_indexes_.push_back(aggr_index);
+      }
+    }
   }
 
-  int aggr_index = 0;
-  for (const PgsqlExpressionPB& expr : request_.targets()) {
-    RETURN_NOT_OK(EvalExpr(expr, table_row, aggr_result_[aggr_index++].Writer()));
+  ++aggr_row_count_;
+  for (auto aggr_index : evaluated_aggr_indexes_) {
+    RETURN_NOT_OK(EvalExpr(
+        request_.targets(aggr_index), table_row, aggr_result_[aggr_index].Writer()));
   }
   return Status::OK();
 }
@@ -1619,7 +1674,11 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
 Status PgsqlReadOperation::PopulateAggregate(WriteBuffer *result_buffer) {
   int column_count = request_.targets().size();
   for (int rscol_index = 0; rscol_index < column_count; rscol_index++) {
-    RETURN_NOT_OK(pggate::WriteColumn(aggr_result_[rscol_index].Value(), result_buffer));
+    auto& aggr_result = aggr_result_[rscol_index];
+    if (IsCountOfNotNullConstant(request_.targets(rscol_index))) {
+      aggr_result.Writer().NewValue().set_int64_value(aggr_row_count_);
+    }
+    RETURN_NOT_OK(pggate::WriteColumn(aggr_result.Value(), result_buffer));
   }
   return Status::OK();
 }
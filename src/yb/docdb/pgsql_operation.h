@@ -220,6 +220,12 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   YQLRowwiseIteratorIf::UniPtr table_iter_;
   YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Indexes of aggregate targets that have to be evaluated for each row.
+  // COUNT(*) targets are not listed here, they are calculated from aggr_row_count_.
+  std::vector<int> evaluated_aggr_indexes_;
+  // Number of rows passed to EvalAggregate.
+  int64_t aggr_row_count_ = 0;
 };
 
 }  // namespace docdb
@@ -29,9 +29,6 @@ namespace docdb {
 
 namespace {
 
-// Used to mark column as skipped by packer. For instance in case of collection column.
-constexpr int64_t kSkippedColumnIdx = -1;
-
 bool IsVarlenColumn(TableType table_type, const ColumnSchema& column_schema) {
   // CQL columns could have individual TTL.
   return table_type == TableType::YQL_TABLE_TYPE ||
@@ -135,12 +132,17 @@ Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
   return Slice(packed.data() + offset, packed.data() + end);
 }
 
-std::optional<Slice> SchemaPacking::GetValue(ColumnId column_id, const Slice& packed) const {
+int64_t SchemaPacking::GetIndex(ColumnId column_id) const {
   auto it = column_to_idx_.find(column_id);
-  if (it == column_to_idx_.end() || it->second == kSkippedColumnIdx) {
+  return it != column_to_idx_.end() ? it->second : kSkippedColumnIdx;
+}
+
+std::optional<Slice> SchemaPacking::GetValue(ColumnId column_id, const Slice& packed) const {
+  auto idx = GetIndex(column_id);
+  if (idx == kSkippedColumnIdx) {
     return {};
   }
-  return GetValue(it->second, packed);
+  return GetValue(idx, packed);
 }
 
 std::string SchemaPacking::ToString() const {
@@ -33,6 +33,10 @@ namespace docdb {
 
 YB_STRONGLY_TYPED_BOOL(OverwriteSchemaPacking);
 
+// Index of the column that is not present in schema packing. Used to mark column as skipped by
+// packer, for instance in case of collection column.
+constexpr int64_t kSkippedColumnIdx = -1;
+
 struct ColumnPackingData {
   ColumnId id;
 
@@ -84,6 +88,11 @@ class SchemaPacking {
   }
 
   bool SkippedColumn(ColumnId column_id) const;
+
+  // Returns index of the column with specified id in this packing, or kSkippedColumnIdx if this
+  // column is not packed. Could be used to resolve column ids once and then access values by index.
+  int64_t GetIndex(ColumnId column_id) const;
+
   Slice GetValue(size_t idx, const Slice& packed) const;
   std::optional<Slice> GetValue(ColumnId column_id, const Slice& packed) const;
   void ToPB(SchemaPackingPB* out) const;
@@ -52,6 +52,10 @@ class EncryptedRandomAccessFile : public RandomAccessFileWrapper {
 
   Result<uint64_t> Size() const override;
 
+  void Readahead(uint64_t offset, size_t n) override {
+    RandomAccessFileWrapper::Readahead(offset + header_size_, n);
+  }
+
   virtual bool IsEncrypted() const override {
     return true;
   }
@@ -44,6 +44,8 @@
 using namespace std::literals;
 
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_bool(memstore_flush_by_score);
+DECLARE_uint64(memstore_flush_min_bytes);
 DECLARE_int64(global_memstore_size_percentage);
 DECLARE_int64(global_memstore_size_mb_max);
 DECLARE_int32(memstore_size_mb);
@@ -265,7 +267,35 @@ TEST_F(FlushITest, TestFlushHappens) {
   ASSERT_GT(flushed_after_writes, 0);
 }
 
+TEST_F(FlushITest, TestFlushSkipsSmallMemtables) {
+  FLAGS_memstore_flush_min_bytes = 256_KB;
+
+  // Write a few rows, so the tablets of this table have the oldest, but small, memtables.
+  WriteAtLeast(kPayloadBytes * 3);
+  std::unordered_set<TabletId> small_tablets;
+  for (auto& peer : cluster_->GetTabletPeers(0)) {
+    small_tablets.insert(peer->tablet_id());
+  }
+
+  SetupWorkload(GetTableName(1));
+  WriteAtLeast((kServerLimitMB * 1_MB) + 1);
+
+  ASSERT_OK(LoggedWaitFor(
+      [this] { return !memory_monitor()->Exceeded(); }, 30s,
+      "Waiting until memory is freed by flushes...", kWaitDelay));
+
+  auto flushed_tablets = tablet_manager_listener_->GetFlushedTablets();
+  ASSERT_FALSE(flushed_tablets.empty());
+  for (const auto& tablet_id : flushed_tablets) {
+    ASSERT_EQ(small_tablets.count(tablet_id), 0)
+        << "Flushed tablet with small memtable: " << tablet_id;
+  }
+}
+
 void FlushITest::TestFlushPicksOldestInactiveTabletAfterCompaction(bool with_restart) {
+  // The flush order checked below is the one of the oldest write policy.
+  FLAGS_memstore_flush_by_score = false;
+
   // Trigger compaction early.
   FLAGS_rocksdb_level0_file_num_compaction_trigger = 2;
 
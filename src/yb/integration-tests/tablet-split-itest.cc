@@ -136,6 +136,9 @@ DECLARE_int64(tablet_split_high_phase_shard_count_per_node);
 DECLARE_int64(tablet_split_low_phase_size_threshold_bytes);
 DECLARE_int64(tablet_split_high_phase_size_threshold_bytes);
 DECLARE_int64(tablet_force_split_threshold_bytes);
+DECLARE_double(tablet_split_load_threshold_ops_per_sec);
+DECLARE_int64(tablet_split_load_min_size_bytes);
+DECLARE_double(tablet_split_load_min_size_ratio);
 DECLARE_int32(tserver_heartbeat_metrics_interval_ms);
 DECLARE_bool(TEST_validate_all_tablet_candidates);
 DECLARE_uint64(outstanding_tablet_split_limit);
@@ -1353,6 +1356,67 @@ TEST_F(AutomaticTabletSplitITest, PrioritizeLargeTablets) {
   }
 }
 
+// This test verifies that a tablet that is far below the size thresholds is split once the load
+// on its leader exceeds tablet_split_load_threshold_ops_per_sec.
+TEST_F(AutomaticTabletSplitITest, LoadBasedSplitting) {
+  constexpr int kNumRows = 1000;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_low_phase_size_threshold_bytes) = 1_GB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_min_size_bytes) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_min_size_ratio) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_disable_compactions) = true;
+
+  CreateSingleTablet();
+  ASSERT_OK(WriteRowsAndFlush(kNumRows));
+
+  // Load based splitting is disabled, so the tablet is too small to be split.
+  SleepForBgTaskIters(2);
+  ASSERT_EQ(ListTableActiveTabletLeadersPeers(cluster_.get(), table_->id()).size(), 1);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_threshold_ops_per_sec) = 10;
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    // Reads could fail while the tablet is being split, they only have to generate load.
+    WARN_NOT_OK(CheckRowsCount(kNumRows), "Failed to read rows");
+    return ListTableActiveTabletLeadersPeers(cluster_.get(), table_->id()).size() == 2;
+  }, 60s * kTimeMultiplier, "Wait for load based split"));
+
+  ASSERT_OK(WaitForTabletSplitCompletion(/* expected_non_split_tablets = */ 2));
+  ASSERT_OK(CheckRowsCount(kNumRows));
+}
+
+// This test verifies that a hot tablet is not split because of its load while it is smaller than
+// tablet_split_load_min_size_ratio of the low phase size threshold.
+TEST_F(AutomaticTabletSplitITest, LoadBasedSplittingMinSize) {
+  constexpr int kNumRows = 1000;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_low_phase_size_threshold_bytes) = 1_GB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_min_size_bytes) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_threshold_ops_per_sec) = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_disable_compactions) = true;
+
+  CreateSingleTablet();
+  ASSERT_OK(WriteRowsAndFlush(kNumRows));
+
+  // The tablet is hot, but far below the minimal size for load based splitting.
+  const auto deadline = CoarseMonoClock::Now() + 10s * kTimeMultiplier;
+  while (CoarseMonoClock::Now() < deadline) {
+    ASSERT_OK(CheckRowsCount(kNumRows));
+    SleepForBgTaskIters(1);
+  }
+  ASSERT_EQ(ListTableActiveTabletLeadersPeers(cluster_.get(), table_->id()).size(), 1);
+
+  // Without the minimal size, the same load splits the tablet.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_min_size_ratio) = 0;
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    // Reads could fail while the tablet is being split, they only have to generate load.
+    WARN_NOT_OK(CheckRowsCount(kNumRows), "Failed to read rows");
+    return ListTableActiveTabletLeadersPeers(cluster_.get(), table_->id()).size() == 2;
+  }, 60s * kTimeMultiplier, "Wait for load based split"));
+
+  ASSERT_OK(WaitForTabletSplitCompletion(/* expected_non_split_tablets = */ 2));
+  ASSERT_OK(CheckRowsCount(kNumRows));
+}
+
 // This test verifies that a tablet only splits if it has at least much SST data as the split
 // threshold for the current phase.
 TEST_F(AutomaticTabletSplitITest, AutomaticTabletSplittingMultiPhase) {
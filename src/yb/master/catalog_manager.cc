@@ -453,6 +453,19 @@ DEFINE_RUNTIME_int64(tablet_force_split_threshold_bytes, 100_GB,
     "tablets from forming in your cluster even if both automatic splitting phases have "
     "been finished.");
 
+DEFINE_RUNTIME_double(tablet_split_load_threshold_ops_per_sec, 0,
+    "The number of read and write operations per second handled by the tablet leader above "
+    "which to split the tablet regardless of its size, until the table reaches "
+    "tablet_split_high_phase_shard_count_per_node tablets per node. 0 disables load based "
+    "splitting.");
+DEFINE_RUNTIME_int64(tablet_split_load_min_size_bytes, 16_MB,
+    "The minimum tablet size for splitting a tablet because of its load. See "
+    "tablet_split_load_threshold_ops_per_sec.");
+DEFINE_RUNTIME_double(tablet_split_load_min_size_ratio, 0.125,
+    "The minimum tablet size for splitting a tablet because of its load, as a fraction of "
+    "tablet_split_low_phase_size_threshold_bytes. Prevents a small hot tablet from being split "
+    "over and over. The tablet should also have at least tablet_split_load_min_size_bytes.");
+
 DEFINE_test_flag(bool, crash_server_on_sys_catalog_leader_affinity_move, false,
                  "When set, crash the master process if it performs a sys catalog leader affinity "
                  "move.");
@@ -2854,7 +2867,14 @@ Status CatalogManager::ShouldSplitValidCandidate(
   }
   ssize_t size = drive_info.sst_files_size;
   DCHECK(size >= 0) << "Detected overflow in casting sst_files_size to signed int.";
-  if (size < FLAGS_tablet_split_low_phase_size_threshold_bytes) {
+  const auto load_threshold = FLAGS_tablet_split_load_threshold_ops_per_sec;
+  const auto ops_per_sec = drive_info.read_ops_per_sec + drive_info.write_ops_per_sec;
+  const auto hot_min_size = std::max<double>(
+      FLAGS_tablet_split_load_min_size_bytes,
+      FLAGS_tablet_split_low_phase_size_threshold_bytes * FLAGS_tablet_split_load_min_size_ratio);
+  const bool is_hot = load_threshold > 0 && ops_per_sec >= load_threshold &&
+                      size >= hot_min_size;
+  if (!is_hot && size < FLAGS_tablet_split_low_phase_size_threshold_bytes) {
     return STATUS_FORMAT(IllegalState, "Tablet $0 SST size ($0) < low phase size threshold ($1).",
         tablet_info.id(), size, FLAGS_tablet_split_low_phase_size_threshold_bytes);
   }
@@ -2890,6 +2910,12 @@ Status CatalogManager::ShouldSplitValidCandidate(
   }
   int64 num_tablets_per_server = tablet_info.table()->NumPartitions() / num_servers;
 
+  if (is_hot && num_tablets_per_server < FLAGS_tablet_split_high_phase_shard_count_per_node) {
+    VLOG(2) << Format("Tablet $0 handles $1 ops/sec >= tablet_split_load_threshold_ops_per_sec "
+                      "($2), splitting it by load.",
+                      tablet_info.tablet_id(), ops_per_sec, load_threshold);
+    return Status::OK();
+  }
   if (num_tablets_per_server < FLAGS_tablet_split_low_phase_shard_count_per_node) {
     if (size <= FLAGS_tablet_split_low_phase_size_threshold_bytes) {
       return STATUS_FORMAT(IllegalState,
@@ -12671,7 +12697,9 @@ void CatalogManager::ProcessTabletStorageMetadata(
         storage_metadata.sst_file_size(),
         storage_metadata.wal_file_size(),
         storage_metadata.uncompressed_sst_file_size(),
-        storage_metadata.may_have_orphaned_post_split_data()};
+        storage_metadata.may_have_orphaned_post_split_data(),
+        storage_metadata.read_ops_per_sec(),
+        storage_metadata.write_ops_per_sec()};
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
 }
 
@@ -84,4 +84,29 @@ inline void GenerateCachePrefix(
 
 } // namespace block_based_table
 
+// Detects sequential reads of data blocks from the file by an iterator and asks the file to read
+// ahead the following data blocks, so the next cache misses of the scan do not wait for the disk.
+// Readahead size starts from a small value and is doubled on each readahead, up to the limit
+// specified by rocksdb_max_data_block_readahead_size.
+// Is not thread safe, supposed to be owned by a single iterator.
+class DataBlockReadahead {
+ public:
+  // Should be called before the data block with the specified handle is read from the file.
+  void BlockRead(yb::RandomAccessFile* file, const BlockHandle& handle);
+
+  // Should be called when the data block with the specified handle is found in the block cache, so
+  // cached blocks in the middle of a sequential scan don't reset the readahead.
+  void BlockCacheHit(const BlockHandle& handle);
+
+ private:
+  void Reset(uint64_t next_block_offset);
+
+  // Offset of the first byte after the last data block read from the file.
+  uint64_t next_block_offset_ = 0;
+  size_t num_sequential_reads_ = 0;
+  // Offset of the first byte after the range that was already requested to be read ahead.
+  uint64_t readahead_limit_ = 0;
+  size_t readahead_size_ = 0;
+};
+
 } // namespace rocksdb
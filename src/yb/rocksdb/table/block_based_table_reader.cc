@@ -62,13 +62,21 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_RUNTIME_uint64(rocksdb_max_data_block_readahead_size, 256_KB,
+    "Max number of bytes to read ahead when an iterator reads data blocks of an SST file "
+    "sequentially from disk. 0 - disable readahead.");
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -245,9 +253,58 @@ struct BlockBasedTable::Rep {
   yb::MemTrackerPtr mem_tracker;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+namespace {
+
+// Readahead is started only after this number of sequential data block reads, so point lookups and
+// short scans don't read extra data.
+constexpr size_t kMinSequentialReadsForReadahead = 2;
+constexpr size_t kInitialReadaheadSize = 8_KB;
+
+} // namespace
+
+void DataBlockReadahead::BlockRead(yb::RandomAccessFile* file, const BlockHandle& handle) {
+  const auto max_readahead_size = FLAGS_rocksdb_max_data_block_readahead_size;
+  const auto block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+  if (handle.offset() != next_block_offset_ || max_readahead_size == 0) {
+    Reset(block_end);
+    return;
+  }
+  next_block_offset_ = block_end;
+  readahead_size_ = std::min<size_t>(readahead_size_, max_readahead_size);
+  // Request the next range when less than half of the previous one is left, so the disk read
+  // overlaps with processing of the blocks that are already in memory.
+  if (++num_sequential_reads_ < kMinSequentialReadsForReadahead ||
+      readahead_limit_ > block_end + readahead_size_ / 2) {
+    return;
+  }
+  const auto readahead_start = std::max(block_end, readahead_limit_);
+  file->Readahead(readahead_start, readahead_size_);
+  readahead_limit_ = readahead_start + readahead_size_;
+  readahead_size_ = std::min<size_t>(readahead_size_ * 2, max_readahead_size);
+}
+
+void DataBlockReadahead::BlockCacheHit(const BlockHandle& handle) {
+  const auto block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+  if (handle.offset() != next_block_offset_) {
+    Reset(block_end);
+    return;
+  }
+  next_block_offset_ = block_end;
+}
+
+void DataBlockReadahead::Reset(uint64_t next_block_offset) {
+  next_block_offset_ = next_block_offset;
+  num_sequential_reads_ = 0;
+  readahead_limit_ = 0;
+  readahead_size_ = kInitialReadaheadSize;
+}
+
+// BlockEntryIteratorState doesn't store any iterator state except data block readahead and is only
+// used as an adapter to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to
+// call BlockBasedTable functions in order to check if prefix may match or to create a secondary
+// iterator.
+// The state for index blocks is shared by all index iterators of the table, so readahead is only
+// tracked by the data block state, which is created for each iterator.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -257,10 +314,15 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         table_(table),
         read_options_(read_options),
         skip_filters_(skip_filters),
-        block_type_(block_type) {}
+        block_type_(block_type) {
+    if (block_type_ == BlockType::kData) {
+      readahead_ = std::make_unique<DataBlockReadahead>();
+    }
+  }
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
-    return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
+    return table_->NewDataBlockIterator(
+        read_options_, index_value, block_type_, /* input_iter = */ nullptr, readahead_.get());
   }
 
   bool PrefixMayMatch(const Slice& internal_key) override {
@@ -278,6 +340,7 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+  unique_ptr<DataBlockReadahead> readahead_;
 };
 
 
@@ -1169,7 +1232,7 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 
 yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock(
     const ReadOptions& ro, const Slice& index_value,
-    const BlockType block_type, const bool use_cache) {
+    const BlockType block_type, const bool use_cache, DataBlockReadahead* readahead) {
   const bool no_io = (ro.read_tier == kBlockCacheTier);
   Cache* block_cache = rep_->table_options.block_cache.get();
   Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
@@ -1205,8 +1268,15 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
         rep_->table_options.format_version, block_type, rep_->mem_tracker);
 
+    if (block.value != nullptr && readahead) {
+      readahead->BlockCacheHit(handle);
+    }
+
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
+      if (readahead) {
+        readahead->BlockRead(reader->reader->file(), handle);
+      }
       {
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
@@ -1233,6 +1303,9 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
     return ReturnNoIOError();
   }
 
+  if (readahead) {
+    readahead->BlockRead(reader->reader->file(), handle);
+  }
   std::unique_ptr<Block> block_value;
   RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
       reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
@@ -1252,10 +1325,11 @@ yb::Result<std::unique_ptr<Block>> BlockBasedTable::RetrieveBlockFromFile(const
 }
 
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
-    const Slice& index_value, BlockType block_type, BlockIter* input_iter) {
+    const Slice& index_value, BlockType block_type, BlockIter* input_iter,
+    DataBlockReadahead* readahead) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
-  auto block = RetrieveBlock(ro, index_value, block_type);
+  auto block = RetrieveBlock(ro, index_value, block_type, /* use_cache = */ true, readahead);
   if (block) {
     InternalIterator* iter = block->value->NewIterator(
         rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter);
@@ -43,6 +43,7 @@ class Block;
 class BlockIter;
 class BlockHandle;
 class Cache;
+class DataBlockReadahead;
 class FilterBlockReader;
 class BlockBasedFilterBlockReader;
 class FullFilterBlockReader;
@@ -194,10 +195,10 @@ class BlockBasedTable : public TableReader {
 
   // Converts an index entry (i.e. an encoded BlockHandle) into an iterator over the contents of
   // a correspoding block. Updates and returns input_iter if the one is specified, or returns
-  // a new iterator.
+  // a new iterator. If readahead is specified, it is notified about block reads from the file.
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
-      BlockIter* input_iter = nullptr);
+      BlockIter* input_iter = nullptr, DataBlockReadahead* readahead = nullptr);
 
   const ImmutableCFOptions& ioptions();
 
@@ -324,7 +325,7 @@ class BlockBasedTable : public TableReader {
   // Retrieves block from file system or cache.
   // NOTE! A caller is responsible for a block cleanup.
   yb::Result<CachableEntry<Block>> RetrieveBlock(const ReadOptions& ro, const Slice& index_value,
-      BlockType block_type, bool use_cache = true);
+      BlockType block_type, bool use_cache = true, DataBlockReadahead* readahead = nullptr);
 
   explicit BlockBasedTable(Rep* rep) : rep_(rep) {}
 
@@ -28,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -49,6 +50,7 @@
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
+#include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/block_builder.h"
 #include "yb/rocksdb/table/format.h"
@@ -74,6 +76,7 @@ using std::unique_ptr;
 using namespace std::literals;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_uint64(rocksdb_max_data_block_readahead_size);
 
 namespace rocksdb {
 
@@ -1894,6 +1897,154 @@ TEST_F(BlockBasedTableTest, InvalidOptions) {
   ValidateBlockRestartInterval(1000, 1000);
 }
 
+namespace {
+
+class ReadaheadRecordingFile : public yb::RandomAccessFile {
+ public:
+  Status Read(uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const override {
+    return STATUS(NotSupported, "Read not supported");
+  }
+
+  Result<uint64_t> Size() const override { return 0; }
+
+  Result<uint64_t> INode() const override { return 0; }
+
+  const std::string& filename() const override { return filename_; }
+
+  size_t memory_footprint() const override { return sizeof(*this); }
+
+  void Readahead(uint64_t offset, size_t n) override {
+    readaheads.emplace_back(offset, n);
+  }
+
+  std::vector<std::pair<uint64_t, size_t>> readaheads;
+
+ private:
+  std::string filename_;
+};
+
+} // namespace
+
+TEST_F(BlockBasedTableTest, DataBlockReadahead) {
+  google::FlagSaver flag_saver;
+  constexpr uint64_t kBlockSize = 4096 - kBlockTrailerSize;
+  constexpr uint64_t kBlockSizeWithTrailer = kBlockSize + kBlockTrailerSize;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_data_block_readahead_size) =
+      4 * kBlockSizeWithTrailer;
+
+  ReadaheadRecordingFile file;
+  DataBlockReadahead readahead;
+  auto read_block = [&](uint64_t idx) {
+    readahead.BlockRead(&file, BlockHandle(idx * kBlockSizeWithTrailer, kBlockSize));
+  };
+  auto cache_hit = [&](uint64_t idx) {
+    readahead.BlockCacheHit(BlockHandle(idx * kBlockSizeWithTrailer, kBlockSize));
+  };
+
+  // Random reads should not trigger readahead.
+  read_block(10);
+  read_block(3);
+  read_block(7);
+  ASSERT_TRUE(file.readaheads.empty());
+
+  // Sequential reads trigger readahead after the second block, readahead size grows up to the
+  // limit, and ranges are not requested twice.
+  for (uint64_t idx = 8; idx != 20; ++idx) {
+    read_block(idx);
+  }
+  ASSERT_FALSE(file.readaheads.empty());
+  ASSERT_EQ(file.readaheads.front().first, 10 * kBlockSizeWithTrailer);
+  for (size_t i = 1; i < file.readaheads.size(); ++i) {
+    const auto& prev = file.readaheads[i - 1];
+    ASSERT_EQ(file.readaheads[i].first, prev.first + prev.second);
+    ASSERT_GE(file.readaheads[i].second, prev.second);
+  }
+  ASSERT_EQ(file.readaheads.back().second, FLAGS_rocksdb_max_data_block_readahead_size);
+
+  // Cache hits of the following blocks keep the sequential read detection.
+  file.readaheads.clear();
+  read_block(50);
+  cache_hit(51);
+  read_block(52);
+  cache_hit(53);
+  read_block(54);
+  ASSERT_FALSE(file.readaheads.empty());
+  ASSERT_EQ(file.readaheads.front().first, 55 * kBlockSizeWithTrailer);
+
+  // Jump resets readahead, also when it is a cache hit.
+  file.readaheads.clear();
+  cache_hit(80);
+  read_block(100);
+  read_block(101);
+  ASSERT_TRUE(file.readaheads.empty());
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_data_block_readahead_size) = 0;
+  for (uint64_t idx = 102; idx != 110; ++idx) {
+    read_block(idx);
+  }
+  ASSERT_TRUE(file.readaheads.empty());
+}
+
+// Index iterators of the table share the same index block state, while data block readahead is
+// tracked per iterator. Check that concurrent scans over a multi-level index work correctly.
+TEST_F(BlockBasedTableTest, ConcurrentIteratorsOnMultiLevelIndex) {
+  google::FlagSaver flag_saver;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_data_block_readahead_size) = 64_KB;
+
+  BlockBasedTableOptions table_options;
+  table_options.index_type = IndexType::kMultiLevelBinarySearch;
+  table_options.block_size = 256;
+  table_options.index_block_size = 256;
+  table_options.min_keys_per_index_block = 2;
+  // Without block cache every data block is read from the file and goes through readahead.
+  table_options.no_block_cache = true;
+
+  TableConstructor c(BytewiseComparator());
+  constexpr int kNumKeys = 5000;
+  for (int i = 0; i != kNumKeys; ++i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "key%06d", i);
+    InternalKey key(buf, 0, kTypeValue);
+    c.Add(key.Encode().ToString(), "value");
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  auto comparator = std::make_shared<InternalKeyComparator>(BytewiseComparator());
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, comparator, &keys, &kvmap);
+  {
+    auto props = c.GetTableProperties().user_collected_properties;
+    auto pos = props.find(BlockBasedTablePropertyNames::kNumIndexLevels);
+    ASSERT_NE(pos, props.end());
+    ASSERT_GE(DecodeFixed32(pos->second.c_str()), 2U);
+  }
+  auto* reader = c.GetTableReader();
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumScansPerThread = 5;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([reader, &kvmap] {
+      for (int scan = 0; scan != kNumScansPerThread; ++scan) {
+        std::unique_ptr<InternalIterator> iter(reader->NewIterator(ReadOptions::kDefault));
+        auto expected = kvmap.begin();
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+          ASSERT_NE(expected, kvmap.end());
+          ASSERT_EQ(iter->key().ToBuffer(), expected->first);
+        }
+        ASSERT_OK(iter->status());
+        ASSERT_EQ(expected, kvmap.end());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 TEST_F(BlockBasedTableTest, BlockReadCountTest) {
   // bloom_filter_type = 0 -- block-based filter
   // bloom_filter_type = 1 -- full filter
@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -49,6 +52,12 @@ DEFINE_UNKNOWN_bool(cache_overflow_single_touch, true,
             "Whether to enable overflow of single touch cache into the multi touch cache "
             "allocation");
 
+DEFINE_UNKNOWN_double(cache_single_touch_history_ratio, 0,
+              "Total charge of entries evicted from the single-touch cache, whose keys are "
+              "remembered, as a fraction of the cache capacity. Such keys are inserted directly "
+              "into the multi-touch cache when they are requested again, so the working set that "
+              "was evicted by a large scan is restored after the scan. 0 disables this history.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -263,6 +272,98 @@ class HandleTable {
   }
 };
 
+// History of keys that were evicted from the single touch sub cache, i.e. before being touched by
+// another query. Only key hashes are stored, so false positives are possible, but that only
+// affects which sub cache the entry is inserted into.
+// Keys of the working set, that were evicted by a large scan, are found in the history when they
+// are inserted again and are admitted into the multi touch sub cache. See LRUCache::AdmitFromHistory
+// for how a repeated scan is kept from being admitted the same way.
+//
+// The history is a ring buffer of evicted entries with a direct mapped index from key hash to the
+// entry, both allocated by SetCapacity, so Add does not allocate while the shard mutex is held. A
+// newer entry whose hash maps to the same index slot replaces the older one in the index, so the
+// history could miss some keys.
+class EvictedHistory {
+ public:
+  // capacity is the total charge of the entries in the history. The number of entries is also
+  // limited, assuming that they are at least kMinEntryCharge on average.
+  void SetCapacity(size_t capacity) {
+    capacity_ = capacity;
+    const size_t num_entries =
+        capacity == 0 ? 0 : std::max(capacity / kMinEntryCharge, kMinNumEntries);
+    ring_.assign(num_entries, Entry());
+    size_t index_size = 1;
+    while (index_size < num_entries * 2) {
+      index_size <<= 1;
+    }
+    index_.assign(num_entries ? index_size : 0, 0);
+    index_mask_ = index_size - 1;
+    head_ = 0;
+    size_ = 0;
+    usage_ = 0;
+  }
+
+  void Add(uint32_t hash, size_t charge) {
+    if (ring_.empty()) {
+      return;
+    }
+    while (size_ == ring_.size() || (size_ != 0 && usage_ + charge > capacity_)) {
+      PopOldest();
+    }
+    auto position = (head_ + size_) % ring_.size();
+    ring_[position] = Entry {
+      .hash = hash,
+      .charge = charge,
+    };
+    ++size_;
+    usage_ += charge;
+    index_[hash & index_mask_] = position + 1;
+  }
+
+  // Removes key with specified hash from history. Returns true if it was present.
+  bool Extract(uint32_t hash) {
+    if (ring_.empty()) {
+      return false;
+    }
+    auto& index_entry = index_[hash & index_mask_];
+    if (index_entry == 0 || ring_[index_entry - 1].hash != hash) {
+      return false;
+    }
+    index_entry = 0;
+    return true;
+  }
+
+ private:
+  static constexpr size_t kMinEntryCharge = 1024;
+  static constexpr size_t kMinNumEntries = 64;
+
+  struct Entry {
+    uint32_t hash = 0;
+    size_t charge = 0;
+  };
+
+  void PopOldest() {
+    const auto& entry = ring_[head_];
+    auto& index_entry = index_[entry.hash & index_mask_];
+    // Key could be extracted, or replaced in the index by another key, after this entry was added.
+    if (index_entry == head_ + 1) {
+      index_entry = 0;
+    }
+    usage_ -= entry.charge;
+    head_ = (head_ + 1) % ring_.size();
+    --size_;
+  }
+
+  size_t capacity_ = 0;
+  size_t usage_ = 0;
+  std::vector<Entry> ring_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  // Position of the entry in ring_ plus 1, or 0 for no entry.
+  std::vector<size_t> index_;
+  size_t index_mask_ = 0;
+};
+
 // Sub-cache of the LRUCache that is used to track different LRU pointers, capacity and usage.
 class LRUSubCache {
  public:
@@ -435,6 +536,11 @@ class LRUCache {
   LRUSubCache* GetSubCache(const SubCacheType subcache_type);
   LRUSubCache single_touch_sub_cache_;
   LRUSubCache multi_touch_sub_cache_;
+  EvictedHistory single_touch_history_;
+  // The last query that had keys admitted from single_touch_history_, and the total charge of
+  // these keys.
+  QueryId history_admitted_query_id_ = kNoCacheQueryId;
+  size_t history_admitted_charge_ = 0;
 
   size_t total_capacity_;
   size_t multi_touch_capacity_;
@@ -459,6 +565,10 @@ class LRUCache {
   // Checks if the corresponding subcache contains space.
   bool HasFreeSpace(const SubCacheType subcache_type);
 
+  // Returns true if the key, that is inserted by the specified query, was evicted from the single
+  // touch cache recently and should be admitted into the multi touch cache.
+  bool AdmitFromHistory(uint32_t hash, QueryId query_id, size_t charge);
+
   size_t TotalUsage() const {
     return single_touch_sub_cache_.Usage() + multi_touch_sub_cache_.Usage();
   }
@@ -551,6 +661,9 @@ void LRUCache::EvictFromLRU(const size_t charge,
     old->in_cache = false;
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
+    if (subcache_type == SINGLE_TOUCH) {
+      single_touch_history_.Add(old->hash, old->charge);
+    }
     deleted->Add(old);
   }
 }
@@ -562,6 +675,8 @@ void LRUCache::SetCapacity(size_t capacity) {
     MutexLock l(&mutex_);
     multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
     total_capacity_ = capacity;
+    single_touch_history_.SetCapacity(
+        round(FLAGS_cache_single_touch_history_ratio * capacity));
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
   }
@@ -579,53 +694,64 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
-  MutexLock l(&mutex_);
-  LRUHandle* e = table_.Lookup(key, hash);
-  if (e != nullptr) {
-    assert(e->in_cache);
-    // Since the entry is now referenced externally, cannot be evicted, so remove from LRU.
-    if (e->refs == 1) {
-      LRU_Remove(e);
-    }
-    // Increase the number of references and move to state 1. (in cache and not in LRU)
-    e->refs++;
-
-    // Now the handle will be added to the multi touch pool only if it exists.
-    if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
-        e->query_id != query_id) {
-      {
-        LRUHandleDeleter multi_touch_eviction_list(metrics_.get());
-        EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
+  // Entries evicted while moving the found entry to the multi touch cache are freed after mutex
+  // is released.
+  LRUHandleDeleter multi_touch_eviction_list(metrics_.get());
+  LRUHandle* e;
+  size_t charge = 0;
+  SubCacheType subcache_type = SINGLE_TOUCH;
+  {
+    MutexLock l(&mutex_);
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      assert(e->in_cache);
+      // Since the entry is now referenced externally, cannot be evicted, so remove from LRU.
+      if (e->refs == 1) {
+        LRU_Remove(e);
       }
-      // Cannot have any single touch elements in this case.
-      assert(FLAGS_cache_single_touch_ratio != 0);
-      if (!strict_capacity_limit_ ||
-          multi_touch_sub_cache_.Usage() - multi_touch_sub_cache_.LRU_Usage() + e->charge <=
-          multi_touch_capacity_) {
-        e->query_id = kInMultiTouchId;
-        single_touch_sub_cache_.DecrementUsage(e->charge);
-        multi_touch_sub_cache_.IncrementUsage(e->charge);
-       if (metrics_) {
-         metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
-         metrics_->single_touch_cache_usage->DecrementBy(e->charge);
-       }
+      // Increase the number of references and move to state 1. (in cache and not in LRU)
+      e->refs++;
+
+      // Now the handle will be added to the multi touch pool only if it exists.
+      if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
+          e->query_id != query_id) {
+        EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
+        // Cannot have any single touch elements in this case.
+        assert(FLAGS_cache_single_touch_ratio != 0);
+        if (!strict_capacity_limit_ ||
+            multi_touch_sub_cache_.Usage() - multi_touch_sub_cache_.LRU_Usage() + e->charge <=
+            multi_touch_capacity_) {
+          e->query_id = kInMultiTouchId;
+          single_touch_sub_cache_.DecrementUsage(e->charge);
+          multi_touch_sub_cache_.IncrementUsage(e->charge);
+          if (metrics_) {
+            metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
+            metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+          }
+        }
       }
+      // Remember entry properties, since they could be changed by concurrent lookups after the
+      // mutex is released.
+      charge = e->charge;
+      subcache_type = e->GetSubCacheType();
     }
-    if (statistics != nullptr) {
+  }
+
+  // Statistics and metrics are updated outside of the mutex to keep the critical section short.
+  if (statistics != nullptr) {
+    if (e != nullptr) {
       // overall cache hit
       RecordTick(statistics, BLOCK_CACHE_HIT);
       // total bytes read from cache
-      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
-      if (e->GetSubCacheType() == SubCacheType::SINGLE_TOUCH) {
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, charge);
+      if (subcache_type == SubCacheType::SINGLE_TOUCH) {
         RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
-        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
-      } else if (e->GetSubCacheType() == SubCacheType::MULTI_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, charge);
+      } else if (subcache_type == SubCacheType::MULTI_TOUCH) {
         RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
-        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, charge);
       }
-    }
-  } else {
-    if (statistics != nullptr) {
+    } else {
       RecordTick(statistics, BLOCK_CACHE_MISS);
     }
   }
@@ -654,6 +780,25 @@ bool LRUCache::HasFreeSpace(const SubCacheType subcache_type) {
   FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
 }
 
+bool LRUCache::AdmitFromHistory(uint32_t hash, QueryId query_id, size_t charge) {
+  if (!single_touch_history_.Extract(hash)) {
+    return false;
+  }
+  // A scan that is repeated soon enough finds all of its keys in the history. So keys are admitted
+  // from the history only until the query has admitted a tenth of the multi touch capacity, after
+  // that the query is treated as a scan. Only the last query is tracked, which is enough to stop
+  // a scan, that evicts entries from the history much faster than other queries find them there.
+  if (query_id != history_admitted_query_id_) {
+    history_admitted_query_id_ = query_id;
+    history_admitted_charge_ = 0;
+  }
+  if ((history_admitted_charge_ + charge) * 10 > multi_touch_capacity_) {
+    return false;
+  }
+  history_admitted_charge_ += charge;
+  return true;
+}
+
 void LRUCache::Release(Cache::Handle* handle) {
   if (handle == nullptr) {
     return;
@@ -677,6 +822,9 @@ void LRUCache::Release(Cache::Handle* handle) {
         e->in_cache = false;
         Unref(e);
         sub_cache->DecrementUsage(e->charge);
+        if (e->GetSubCacheType() == SINGLE_TOUCH) {
+          single_touch_history_.Add(e->hash, e->charge);
+        }
         last_reference = true;
       } else {
         // put the item on the list to be potentially freed.
@@ -746,6 +894,11 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       subcache_type = SINGLE_TOUCH;
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
+      if (subcache_type == SINGLE_TOUCH && AdmitFromHistory(hash, query_id, charge)) {
+        // The key was evicted from the single touch cache and is requested again.
+        e->query_id = kInMultiTouchId;
+        subcache_type = MULTI_TOUCH;
+      }
     }
     EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
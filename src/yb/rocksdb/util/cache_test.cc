@@ -37,6 +37,7 @@
 using std::shared_ptr;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_double(cache_single_touch_history_ratio);
 
 namespace rocksdb {
 
@@ -467,6 +468,69 @@ TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   ASSERT_LT(kCacheSize * FLAGS_cache_single_touch_ratio, cache_->GetUsage());
 }
 
+// Checks that the key evicted from the single touch cache by a scan is admitted into the multi touch
+// cache when it is requested again.
+TEST_F(CacheTest, EvictedByScan) {
+  const int kCapacity = 100;
+  // Scan that is long enough to evict everything from the cache, but whose evicted keys still fit
+  // into the history.
+  const int kScanSize = kCapacity * 5 / 4;
+  const QueryId kPointQueryId = 1000;
+  const QueryId kScanQueryId = 1001;
+  const QueryId kNextPointQueryId = 1002;
+  for (auto history_ratio : {0.0, 0.5}) {
+    FLAGS_cache_single_touch_history_ratio = history_ratio;
+    auto cache = NewLRUCache(kCapacity, 0);
+    ASSERT_OK(Insert(cache, 100, 101, 1, kPointQueryId));
+    for (int i = 0; i != kScanSize; ++i) {
+      ASSERT_OK(Insert(cache, 1000 + i, 2000 + i, 1, kScanQueryId));
+    }
+    ASSERT_EQ(-1, Lookup(cache, 100, kNextPointQueryId));
+
+    ASSERT_OK(Insert(cache, 100, 101, 1, kNextPointQueryId));
+    ASSERT_EQ(history_ratio != 0, LookupAndCheckInMultiTouch(cache, 100, 101, kNextPointQueryId));
+
+    // Blocks of the next scan should not evict the key from the multi touch cache.
+    for (int i = 0; i != kScanSize; ++i) {
+      ASSERT_OK(Insert(cache, 5000 + i, 6000 + i, 1, kScanQueryId));
+    }
+    ASSERT_EQ(history_ratio != 0 ? 101 : -1, Lookup(cache, 100, kNextPointQueryId));
+  }
+
+  // Returning the flag back.
+  FLAGS_cache_single_touch_history_ratio = 0;
+}
+
+// Checks that a repeated scan, whose keys are all found in the history of the single touch cache,
+// does not fill the multi touch cache.
+TEST_F(CacheTest, RepeatedScanIsNotAdmittedFromHistory) {
+  const int kCapacity = 100;
+  const int kScanSize = kCapacity * 5 / 4;
+  const QueryId kScanQueryId = 1000;
+  const QueryId kNextScanQueryId = 1001;
+  FLAGS_cache_single_touch_history_ratio = 0.5;
+  auto cache = NewLRUCache(kCapacity, 0);
+  for (int i = 0; i != kScanSize; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1, 1, kScanQueryId));
+  }
+  // Repeat the scan over the keys that were evicted, so all of them are found in the history.
+  const int kEvicted = kScanSize - kCapacity;
+  for (int i = 0; i != kEvicted; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1, 1, kNextScanQueryId));
+  }
+
+  // Lookup by the query that inserted the keys does not move them to the multi touch cache.
+  int num_multi_touch = 0;
+  for (int i = 0; i != kEvicted; ++i) {
+    num_multi_touch += LookupAndCheckInMultiTouch(cache, i, i + 1, kNextScanQueryId);
+  }
+  ASSERT_GT(num_multi_touch, 0);
+  ASSERT_LE(num_multi_touch, kCapacity * (1 - FLAGS_cache_single_touch_ratio) / 10);
+
+  // Returning the flag back.
+  FLAGS_cache_single_touch_history_ratio = 0;
+}
+
 TEST_F(CacheTest, HeavyEntries) {
   // Add a bunch of light and heavy entries and then count the combined
   // size of items still in the cache, which must be approximately the
@@ -38,6 +38,11 @@ using namespace std::literals;
 DEFINE_UNKNOWN_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
                                          "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
 
+DEFINE_RUNTIME_uint64(stream_compression_min_size, 128,
+    "Outbound messages smaller than this number of bytes are sent as stored (not compressed) "
+    "blocks. Only applicable to gzip, which can switch compression level without changing "
+    "the stream format.");
+
 namespace yb {
 namespace rpc {
 
@@ -179,10 +184,21 @@ class ZlibCompressor : public Compressor {
 
   Status Compress(
       const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
-    RefCntBuffer output(deflateBound(&deflate_stream_, TotalLen(input)));
+    auto input_size = TotalLen(input);
+    // Changing level could flush pending output of the previous level, so reserve space for it.
+    RefCntBuffer output(deflateBound(&deflate_stream_, input_size) + kChangeLevelReserve);
     deflate_stream_.avail_out = static_cast<unsigned int>(output.size());
     deflate_stream_.next_out = output.udata();
 
+    auto level = ChooseLevel(input_size);
+    if (level != level_) {
+      auto res = deflateParams(&deflate_stream_, level, Z_DEFAULT_STRATEGY);
+      if (res != Z_OK) {
+        return STATUS_FORMAT(RuntimeError, "Cannot change compression level: $0", res);
+      }
+      level_ = level;
+    }
+
     for (auto it = input.begin(); it != input.end();) {
       const auto& buf = *it++;
       deflate_stream_.next_in = const_cast<Bytef*>(buf.udata());
@@ -209,6 +225,14 @@ class ZlibCompressor : public Compressor {
 
     output.Shrink(deflate_stream_.next_out - output.udata());
 
+    if (level_ != Z_NO_COMPRESSION && input_size >= kMinSizeToCheckRatio &&
+        output.size() * kIncompressibleRatioDenominator >
+            input_size * kIncompressibleRatioNumerator) {
+      VLOG_WITH_FUNC(4) << "Incompressible message, input: " << input_size << ", output: "
+                        << output.size();
+      messages_to_store_ = kIncompressibleMessagesToStore;
+    }
+
     // Send compressed data to underlying stream.
     return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
         std::move(output), std::move(data)));
@@ -233,10 +257,36 @@ class ZlibCompressor : public Compressor {
   }
 
  private:
+  static constexpr size_t kChangeLevelReserve = 16;
+  // Compression ratio is checked only for messages of at least this size, since the output of
+  // a small message is dominated by block headers.
+  static constexpr size_t kMinSizeToCheckRatio = 1_KB;
+  // Message is considered incompressible when its output is larger than 9/10 of input.
+  static constexpr size_t kIncompressibleRatioNumerator = 9;
+  static constexpr size_t kIncompressibleRatioDenominator = 10;
+  // Number of messages that are stored after an incompressible one, before we try to compress
+  // again.
+  static constexpr size_t kIncompressibleMessagesToStore = 16;
+
+  // Stored blocks are understood by any inflate implementation, so the level could be chosen
+  // for each message independently from the receiver.
+  int ChooseLevel(size_t input_size) {
+    if (input_size < FLAGS_stream_compression_min_size) {
+      return Z_NO_COMPRESSION;
+    }
+    if (messages_to_store_ > 0) {
+      --messages_to_store_;
+      return Z_NO_COMPRESSION;
+    }
+    return Z_DEFAULT_COMPRESSION;
+  }
+
   z_stream deflate_stream_;
   z_stream inflate_stream_;
   bool deflate_inited_ = false;
   bool inflate_inited_ = false;
+  int level_ = Z_DEFAULT_COMPRESSION;
+  size_t messages_to_store_ = 0;
 };
 
 // Source implementation that provides input from range of buffers.
@@ -86,10 +86,12 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
+DECLARE_uint64(stream_compression_min_size);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_uint64(rpc_read_buffer_size);
+DECLARE_int32(socket_receive_buffer_size);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -1170,6 +1172,15 @@ TEST_F(TestRpcSecure, BigOpWithSmallBuffer) {
   RunSecureTest(&TestBigOp);
 }
 
+// With a small receive buffer on both ends, a big call and its response could not be sent by a
+// single writev. So the sender gets short writes, waits for the socket to become writable and
+// completes the rest of the data from the write handler.
+TEST_F(TestRpc, BigOpWithSmallSocketBuffer) {
+  FLAGS_socket_receive_buffer_size = 4_KB;
+  FLAGS_rpc_read_buffer_size = 128;
+  RunPlainTest(&TestBigOp);
+}
+
 void TestManyOps(CalculatorServiceProxy* proxy) {
   for (int i = 0; i != RegularBuildVsSanitizers(1000, 100); ++i) {
     RpcController controller;
@@ -1268,7 +1279,9 @@ TEST_P(TestRpcCompression, CantAllocateReadBuffer) {
   RunCompressionTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
 
-void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity) {
+void TestCompression(
+    CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity,
+    bool expect_compressed = true) {
   constexpr size_t kStringLen = 4_KB;
 
   size_t prev_sent = 0;
@@ -1293,9 +1306,14 @@ void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metri
       LOG(INFO) << "Sent: " << sent << ", received: " << received;
 
       ASSERT_GT(sent, 10); // Check that metric even work.
-      ASSERT_LE(sent, kStringLen / 5); // Check that compression work.
       ASSERT_GT(received, 10); // Check that metric even work.
-      ASSERT_LE(received, kStringLen / 5); // Check that compression work.
+      if (expect_compressed) {
+        ASSERT_LE(sent, kStringLen / 5); // Check that compression work.
+        ASSERT_LE(received, kStringLen / 5); // Check that compression work.
+      } else {
+        ASSERT_GE(sent, kStringLen);
+        ASSERT_GE(received, kStringLen);
+      }
       break;
     }
 
@@ -1310,6 +1328,40 @@ TEST_P(TestRpcCompression, Compression) {
   });
 }
 
+TEST_P(TestRpcCompression, CompressionMinSize) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_stream_compression_min_size) = 1_MB;
+  // Only gzip sends small messages uncompressed.
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestCompression(proxy, metric_entity(), /* expect_compressed= */ GetParam() != 1);
+  });
+}
+
+// Mixes small, incompressible and compressible messages, so gzip switches compression level
+// in the middle of the stream.
+TEST_P(TestRpcCompression, MixedPayloads) {
+  RunCompressionTest([](CalculatorServiceProxy* proxy) {
+    for (int i = 0; i != 100; ++i) {
+      RpcController controller;
+      controller.set_timeout(5s * kTimeMultiplier);
+      rpc_test::EchoRequestPB req;
+      switch (i % 3) {
+        case 0:
+          req.set_data(RandomHumanReadableString(10));
+          break;
+        case 1:
+          req.set_data(RandomString(4_KB));
+          break;
+        case 2:
+          req.set_data(std::string(4_KB, 'Y'));
+          break;
+      }
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(proxy->Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  });
+}
+
 std::string CompressionName(const testing::TestParamInfo<int>& info) {
   switch (info.param) {
     case 1: return "Zlib";
@@ -213,6 +213,10 @@ Status TcpStream::DoWrite() {
       context_->UpdateLastActivity();
     }
 
+    size_t bytes_to_write = 0;
+    for (int i = 0; i != fill_result.len; ++i) {
+      bytes_to_write += iov[i].iov_len;
+    }
     auto result = fill_result.len != 0
         ? socket_.Writev(iov, fill_result.len)
         : 0;
@@ -251,6 +255,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    // Short write means that socket send buffer is full, so the next write would fail with EAGAIN.
+    // Wait until socket becomes writable instead.
+    if (*result < bytes_to_write) {
+      return Status::OK();
+    }
   }
 
   return Status::OK();
@@ -314,7 +324,8 @@ Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
   for (;;) {
-    auto received = Receive();
+    bool socket_drained = false;
+    auto received = Receive(&socket_drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -336,10 +347,15 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.get()) {
       return Status::OK();
     }
+    // The socket is level triggered, so if more data arrives we will be notified again.
+    // Avoid extra recv call that would just return EAGAIN.
+    if (socket_drained) {
+      return Status::OK();
+    }
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* socket_drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -379,6 +395,8 @@ Result<bool> TcpStream::Receive() {
     return nread.status();
   }
   DVLOG_WITH_PREFIX(4) << "socket_.Recvv() bytes: " << *nread;
+  // Short read means that socket did not have more data available.
+  *socket_drained = *nread < IoVecsFullSize(*iov);
 
   IncrementCounterBy(bytes_received_counter_, *nread);
   ReadBuffer().DataAppended(*nread);
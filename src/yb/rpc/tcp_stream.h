@@ -99,7 +99,10 @@ class TcpStream : public Stream {
   Status ReadHandler();
   Status WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Reads available data from the socket into the read buffer. Returns true if anything was read.
+  // socket_drained is set to true when the socket was certainly drained by this read, i.e. the next
+  // read would fail with EAGAIN.
+  Result<bool> Receive(bool* socket_drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
@@ -14,7 +14,9 @@
 //
 
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
@@ -28,6 +30,7 @@
 #include "yb/util/tsan_util.h"
 
 DECLARE_int32(TEST_strand_done_inject_delay_ms);
+DECLARE_int32(rpc_thread_pool_spin_iterations);
 
 using namespace std::literals;
 
@@ -159,6 +162,82 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+// Reports task throughput for different numbers of workers.
+TEST_F(ThreadPoolTest, TaskThroughput) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping test in quick test mode, since it is a benchmark";
+    return;
+  }
+
+  constexpr size_t kTotalTasks = RegularBuildVsSanitizers(200000, 10000);
+  constexpr size_t kProducers = 4;
+  for (size_t workers : {1, 2, 4, 8, 16}) {
+    ThreadPool pool(ThreadPoolOptions {
+      .name = "test",
+      .max_workers = workers,
+    });
+
+    CountDownLatch latch(kTotalTasks);
+    std::vector<TestTask> tasks(kTotalTasks);
+    std::vector<std::thread> threads;
+    auto start = MonoTime::Now();
+    size_t begin = 0;
+    for (size_t i = 0; i != kProducers; ++i) {
+      size_t end = kTotalTasks * (i + 1) / kProducers;
+      threads.emplace_back([&pool, &latch, &tasks, begin, end] {
+        CDSAttacher attacher;
+        for (size_t i = begin; i != end; ++i) {
+          tasks[i].SetLatch(&latch);
+          ASSERT_TRUE(pool.Enqueue(&tasks[i]));
+        }
+      });
+      begin = end;
+    }
+    latch.Wait();
+    auto passed = MonoTime::Now() - start;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto& task : tasks) {
+      ASSERT_TRUE(task.IsCompleted());
+    }
+    LOG(INFO) << "Workers: " << workers << ", passed: " << passed << ", tasks per second: "
+              << kTotalTasks / passed.ToSeconds();
+  }
+}
+
+// Checks that tasks enqueued one by one are executed by the same worker, whether it is spinning or
+// waiting when the task arrives.
+TEST_F(ThreadPoolTest, SpinningWorkerIsReused) {
+  constexpr size_t kTotalTasks = 100;
+  constexpr size_t kMaxWorkers = 16;
+  // Spin long enough for the worker to still be spinning when the next task arrives.
+  for (int spin_iterations : {0, 10000000}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_thread_pool_spin_iterations) = spin_iterations;
+    std::mutex mutex;
+    std::unordered_set<std::thread::id> worker_ids;
+    std::atomic<size_t> done{0};
+    ThreadPool pool(ThreadPoolOptions {
+      .name = "test",
+      .max_workers = kMaxWorkers,
+    });
+
+    for (size_t i = 0; i != kTotalTasks; ++i) {
+      ASSERT_TRUE(pool.Enqueue(MakeFunctorThreadPoolTask([&mutex, &worker_ids, &done] {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          worker_ids.insert(std::this_thread::get_id());
+        }
+        ++done;
+      })));
+      ASSERT_OK(WaitFor([&done, i] { return done == i + 1; }, 10s, "Task done"));
+      std::this_thread::sleep_for(1ms);
+    }
+    pool.Shutdown();
+    ASSERT_EQ(worker_ids.size(), 1) << "Spin iterations: " << spin_iterations;
+  }
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
@@ -16,15 +16,23 @@
 #include "yb/rpc/thread_pool.h"
 
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/gutil/atomicops.h"
+
+#include "yb/util/flags.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
 #include "yb/util/thread.h"
 
+DEFINE_RUNTIME_int32(rpc_thread_pool_spin_iterations, 100,
+    "Number of times an idle rpc thread pool worker polls the task queue before going to the "
+    "waiting state. Tasks that arrive during this period are picked up without a wakeup.");
+
 namespace yb {
 namespace rpc {
 
@@ -39,6 +47,11 @@ struct ThreadPoolShare {
   ThreadPoolOptions options;
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+  // Number of spinning workers that were not yet claimed by Enqueue, see Worker::Spin.
+  std::atomic<size_t> spinning_workers{0};
+  // Invoked by a claimed spinning worker when a task could still be left in the queue without a
+  // worker that is going to pick it up.
+  std::function<void()> recheck_queue;
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
       : options(std::move(o)) {}
@@ -113,6 +126,9 @@ class Worker {
     if (share_->task_queue.pop(*task)) {
       return true;
     }
+    if (Spin(task)) {
+      return true;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     waiting_task_ = true;
     auto se = ScopeExit([this] {
@@ -141,6 +157,41 @@ class Worker {
     return false;
   }
 
+  // Tasks usually arrive in bursts, e.g. several calls received in one read from a connection.
+  // Polling the queue for a short time lets us pick them up without the condition variable wakeup.
+  //
+  // Spinning workers are not added to waiting_workers. Instead they are counted in
+  // spinning_workers, and Enqueue claims one of them before starting a new worker, so spinning
+  // does not make the pool grow. If we were claimed and give up, the claimed task is found by the
+  // double check in PopTask. If we were claimed and popped a task, it could be a different task,
+  // e.g. one that was queued before we were claimed. Then the claimed task is still in the queue,
+  // and we ask the pool to wake another worker for it instead of leaving it behind our task.
+  bool Spin(ThreadPoolTask** task) {
+    auto iterations = FLAGS_rpc_thread_pool_spin_iterations;
+    if (iterations <= 0) {
+      return false;
+    }
+    share_->spinning_workers.fetch_add(1, std::memory_order_acq_rel);
+    bool result = false;
+    while (iterations-- > 0 && !stop_requested_) {
+      base::subtle::PauseCPU();
+      if (share_->task_queue.pop(*task)) {
+        result = true;
+        break;
+      }
+    }
+    auto spinning = share_->spinning_workers.load(std::memory_order_acquire);
+    while (spinning != 0 &&
+           !share_->spinning_workers.compare_exchange_weak(
+               spinning, spinning - 1, std::memory_order_acq_rel)) {
+    }
+    auto claimed = spinning == 0;
+    if (result && claimed && !share_->task_queue.empty()) {
+      share_->recheck_queue();
+    }
+    return result;
+  }
+
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
       auto pushed = share_->waiting_workers.push(this);
@@ -166,6 +217,7 @@ class ThreadPool::Impl {
       : share_(std::move(options)) {
     LOG(INFO) << "Starting thread pool " << share_.options.ToString();
     workers_.reserve(share_.options.max_workers);
+    share_.recheck_queue = [this] { RecheckQueue(); };
   }
 
   const ThreadPoolOptions& options() const {
@@ -181,36 +233,18 @@ class ThreadPool::Impl {
     }
     bool added = share_.task_queue.push(task);
     DCHECK(added); // BasketQueue always succeed.
-    Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        --adding_;
-        return true;
-      }
-    }
-    --adding_;
+    NotifyWorker();
+    return true;
+  }
 
-    // We increment created_workers_ every time, the first max_worker increments would produce
-    // a new worker. And after that, we will just increment it doing nothing after that.
-    // So we could be lock free here.
-    auto index = created_workers_++;
-    if (index < share_.options.max_workers) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (!closing_) {
-        auto new_worker = std::make_unique<Worker>(&share_);
-        auto status = new_worker->Start(workers_.size());
-        if (status.ok()) {
-          workers_.push_back(std::move(new_worker));
-        } else if (workers_.empty()) {
-          LOG(FATAL) << "Unable to start first worker: " << status;
-        } else {
-          LOG(WARNING) << "Unable to start worker: " << status;
-        }
-      }
-    } else {
-      --created_workers_;
+  // Invoked by a claimed spinning worker that popped a task while the queue is not empty.
+  void RecheckQueue() {
+    ++adding_;
+    if (closing_ || share_.task_queue.empty()) {
+      --adding_;
+      return;
     }
-    return true;
+    NotifyWorker();
   }
 
   void Shutdown() {
@@ -248,6 +282,56 @@ class ThreadPool::Impl {
   }
 
  private:
+  // Makes sure that a worker is going to pick up the queued task: notifies a waiting worker, claims
+  // a spinning worker or starts a new one. Should be invoked with adding_ incremented, decrements it.
+  void NotifyWorker() {
+    Worker* worker = nullptr;
+    while (share_.waiting_workers.pop(worker)) {
+      if (worker->Notify()) {
+        --adding_;
+        return;
+      }
+    }
+    if (ClaimSpinningWorker()) {
+      --adding_;
+      return;
+    }
+    --adding_;
+
+    // We increment created_workers_ every time, the first max_worker increments would produce
+    // a new worker. And after that, we will just increment it doing nothing after that.
+    // So we could be lock free here.
+    auto index = created_workers_++;
+    if (index < share_.options.max_workers) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!closing_) {
+        auto new_worker = std::make_unique<Worker>(&share_);
+        auto status = new_worker->Start(workers_.size());
+        if (status.ok()) {
+          workers_.push_back(std::move(new_worker));
+        } else if (workers_.empty()) {
+          LOG(FATAL) << "Unable to start first worker: " << status;
+        } else {
+          LOG(WARNING) << "Unable to start worker: " << status;
+        }
+      }
+    } else {
+      --created_workers_;
+    }
+  }
+
+  // Returns true if a spinning worker is going to pick up the task that was just queued.
+  bool ClaimSpinningWorker() {
+    auto spinning = share_.spinning_workers.load(std::memory_order_acquire);
+    while (spinning != 0) {
+      if (share_.spinning_workers.compare_exchange_weak(
+              spinning, spinning - 1, std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   ThreadPoolShare share_;
   std::vector<std::unique_ptr<Worker>> workers_;
   std::atomic<size_t> created_workers_ = {0};
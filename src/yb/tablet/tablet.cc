@@ -3533,6 +3533,23 @@ std::pair<int, int> Tablet::GetNumMemtables() const {
   return std::make_pair(intents_num_memtables, regular_num_memtables);
 }
 
+uint64_t Tablet::GetMutableMemtablesSize() const {
+  auto scoped_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_operation.ok()) {
+    return 0;
+  }
+
+  uint64_t result = 0;
+  std::lock_guard<rw_spinlock> lock(component_lock_);
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    uint64_t size = 0;
+    if (db && db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+      result += size;
+    }
+  }
+  return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContext> Tablet::CreateTransactionOperationContext(
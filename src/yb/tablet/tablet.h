@@ -621,6 +621,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns the number of memtables in intents and regular db-s.
   std::pair<int, int> GetNumMemtables() const;
 
+  // Returns the total approximate size of the mutable memtables of intents and regular db-s.
+  uint64_t GetMutableMemtablesSize() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -0,0 +1,57 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tserver/tablet_memory_manager.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(db_block_cache_num_shard_bits);
+
+namespace yb {
+namespace tserver {
+
+class TabletMemoryManagerTest : public YBTest {};
+
+TEST_F(TabletMemoryManagerTest, BlockCacheNumShardBits) {
+  // Small core count is clamped to the minimal number of shards.
+  ASSERT_EQ(BlockCacheNumShardBits(8_GB, 1), 4);
+  ASSERT_EQ(BlockCacheNumShardBits(8_GB, 2), 4);
+  ASSERT_EQ(BlockCacheNumShardBits(8_GB, 12), 4);
+
+  // Number of shards follows the number of cores, rounded up to a power of two.
+  ASSERT_EQ(BlockCacheNumShardBits(16_GB, 48), 6);
+  ASSERT_EQ(BlockCacheNumShardBits(64_GB, 128), 7);
+
+  // Large core count is clamped to the maximal number of shards.
+  ASSERT_EQ(BlockCacheNumShardBits(1024_GB, 4096), 10);
+
+  // Shards are not made smaller than 32MB.
+  ASSERT_EQ(BlockCacheNumShardBits(1_GB, 128), 5);
+  ASSERT_EQ(BlockCacheNumShardBits(4_GB, 4096), 7);
+
+  // Small capacity could not satisfy the 32MB floor, but we still keep the minimal number of
+  // shards.
+  ASSERT_EQ(BlockCacheNumShardBits(64_MB, 64), 4);
+  ASSERT_EQ(BlockCacheNumShardBits(64_MB, 1), 4);
+
+  // Explicitly specified number of shard bits is used as is.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_db_block_cache_num_shard_bits) = 2;
+  ASSERT_EQ(BlockCacheNumShardBits(8_GB, 128), 2);
+}
+
+} // namespace tserver
+} // namespace yb
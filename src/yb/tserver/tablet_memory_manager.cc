@@ -13,15 +13,21 @@
 
 #include "yb/tserver/tablet_memory_manager.h"
 
+#include <algorithm>
+
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/raft_consensus.h"
 
+#include "yb/gutil/bits.h"
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/human_readable.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
 
+#include "yb/server/clock.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
@@ -30,6 +36,8 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
@@ -51,6 +59,42 @@ DEFINE_UNKNOWN_int64(global_memstore_size_mb_max, 2048,
              "memory. However, this flag limits it in absolute size. Value of 0 "
              "means no limit on the value obtained by the percentage. Default is 2048.");
 
+DEFINE_RUNTIME_bool(memstore_flush_by_score, true,
+    "When the global memstore limit is reached, flush the tablet with the highest score, which "
+    "grows with the size and the age of its mutable memtable. See memstore_flush_min_bytes and "
+    "memstore_flush_age_weight_sec. If false, flush the tablet with the oldest memtable write.");
+
+DEFINE_RUNTIME_uint64(memstore_flush_min_bytes, 1_MB,
+    "When the global memstore limit is reached, tablets with mutable memtables smaller than this "
+    "are flushed only if no other tablet has a larger memtable. Used with "
+    "memstore_flush_by_score.");
+
+DEFINE_RUNTIME_uint32(memstore_flush_age_weight_sec, 300,
+    "The memtable age at which the flush score of a tablet is double the size of its mutable "
+    "memtable. Lower values favor flushing old memtables, which retain WAL, over large ones. 0 "
+    "means the age is ignored. Used with memstore_flush_by_score.");
+
+METRIC_DEFINE_counter(server, memstore_flushes_oldest_write,
+                      "Memstore Flushes Of Oldest Write",
+                      yb::MetricUnit::kRequests,
+                      "Number of flushes started because of the global memstore limit, on the "
+                      "tablet with the oldest memtable write");
+METRIC_DEFINE_counter(server, memstore_flushes_memtable_size,
+                      "Memstore Flushes By Memtable Size",
+                      yb::MetricUnit::kRequests,
+                      "Number of flushes started because of the global memstore limit, on the "
+                      "tablet whose flush score came mostly from the size of its memtable");
+METRIC_DEFINE_counter(server, memstore_flushes_memtable_age,
+                      "Memstore Flushes By Memtable Age",
+                      yb::MetricUnit::kRequests,
+                      "Number of flushes started because of the global memstore limit, on the "
+                      "tablet whose flush score came mostly from the age of its memtable");
+METRIC_DEFINE_counter(server, memstore_flushes_small_memtable,
+                      "Memstore Flushes Of Small Memtables",
+                      yb::MetricUnit::kRequests,
+                      "Number of flushes started because of the global memstore limit, on a "
+                      "tablet with a memtable below memstore_flush_min_bytes");
+
 namespace {
   constexpr int kDbCacheSizeUsePercentage = -1;
   constexpr int kDbCacheSizeCacheDisabled = -2;
@@ -72,8 +116,10 @@ DEFINE_UNKNOWN_int32(db_block_cache_size_percentage, kDbCacheSizeUseDefault,
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes. "
              "Defaults to -3 (use default percentage as defined by master or tserver).");
 
-DEFINE_UNKNOWN_int32(db_block_cache_num_shard_bits, 4,
-             "Number of bits to use for sharding the block cache (defaults to 4 bits)");
+DEFINE_UNKNOWN_int32(db_block_cache_num_shard_bits, -1,
+             "Number of bits to use for sharding the block cache. -1 means that the number of "
+             "shards is selected based on the number of cores and block cache size, but at least "
+             "4 bits are used.");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
@@ -86,6 +132,31 @@ using strings::Substitute;
 
 namespace {
 
+// Minimal and maximal number of shard bits used for automatically sharded block cache.
+constexpr int kMinAutoBlockCacheNumShardBits = 4;
+constexpr int kMaxAutoBlockCacheNumShardBits = 10;
+// Block cache shards are not made smaller than this size when shard bits are selected
+// automatically, to avoid evicting hot entries from overloaded shards.
+constexpr int64_t kMinAutoBlockCacheShardSize = 32_MB;
+
+}  // namespace
+
+// Each block cache shard is protected by its own mutex, so the number of shards should grow with
+// the number of cores to avoid mutex contention under point read load.
+int BlockCacheNumShardBits(int64_t block_cache_size_bytes, int num_cpus) {
+  if (FLAGS_db_block_cache_num_shard_bits >= 0) {
+    return FLAGS_db_block_cache_num_shard_bits;
+  }
+  int result = Bits::Log2Ceiling(static_cast<uint32_t>(num_cpus));
+  while (result > kMinAutoBlockCacheNumShardBits &&
+         (block_cache_size_bytes >> result) < kMinAutoBlockCacheShardSize) {
+    --result;
+  }
+  return std::clamp(result, kMinAutoBlockCacheNumShardBits, kMaxAutoBlockCacheNumShardBits);
+}
+
+namespace {
+
 class FunctorGC : public GarbageCollector {
  public:
   explicit FunctorGC(std::function<void(size_t)> impl) : impl_(std::move(impl)) {}
@@ -150,6 +221,17 @@ size_t GetLogCacheSize(tablet::TabletPeer* peer) {
   return down_cast<consensus::RaftConsensus*>(peer->consensus())->LogCacheSize();
 }
 
+// Returns the flush score of a memtable with the specified size and age. Flushing a large memtable
+// frees the most memory and writes a large SST file, which costs less compaction work later. The
+// age is the size divided by the write rate, so an old memtable belongs to a tablet that is written
+// slowly. Such a memtable is not going to reach memstore_size_mb and flush on its own soon, and the
+// tablet has to retain all WAL written since the oldest write in it.
+double FlushScore(uint64_t memtable_size, MonoDelta memtable_age) {
+  const auto age_weight_sec = FLAGS_memstore_flush_age_weight_sec;
+  const auto age_factor = age_weight_sec ? memtable_age.ToSeconds() / age_weight_sec : 0.0;
+  return memtable_size * (1.0 + age_factor);
+}
+
 }  // namespace
 
 TabletMemoryManager::TabletMemoryManager(
@@ -161,12 +243,23 @@ TabletMemoryManager::TabletMemoryManager(
   server_mem_tracker_ = mem_tracker;
   peers_fn_ = peers_fn;
 
+  if (metrics) {
+    flush_reason_counters_ = {
+      METRIC_memstore_flushes_oldest_write.Instantiate(metrics),
+      METRIC_memstore_flushes_memtable_size.Instantiate(metrics),
+      METRIC_memstore_flushes_memtable_age.Instantiate(metrics),
+      METRIC_memstore_flushes_small_memtable.Instantiate(metrics),
+    };
+  }
+
   InitBlockCache(metrics, default_block_cache_size_percentage, options);
   InitLogCacheGC();
   // Assign background_task_ if necessary.
   ConfigureBackgroundTask(options);
 }
 
+TabletMemoryManager::~TabletMemoryManager() = default;
+
 Status TabletMemoryManager::Init() {
   if (background_task_) {
     RETURN_NOT_OK(background_task_->Init());
@@ -196,8 +289,10 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    auto num_shard_bits = BlockCacheNumShardBits(block_cache_size_bytes, base::NumCPUs());
+    LOG(INFO) << "Block cache size: " << block_cache_size_bytes
+              << ", num shard bits: " << num_shard_bits;
+    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes, num_shard_bits);
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -289,21 +384,35 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
     YB_LOG_EVERY_N_SECS(INFO, 5) << Format("Memstore global limit of $0 bytes reached, looking for "
                                            "tablet to flush", memory_monitor_->limit());
     auto flush_tick = rocksdb::FlushTick();
-    tablet::TabletPeerPtr peer_to_flush = TabletToFlush();
+    auto to_flush = TabletToFlush();
+    const auto& peer_to_flush = to_flush.peer;
     if (peer_to_flush) {
       auto tablet_to_flush = peer_to_flush->shared_tablet();
       // TODO(bojanserafimov): If peer_to_flush flushes now because of other reasons,
       // we will schedule a second flush, which will unnecessarily stall writes for a short time.
       // This will not happen often, but should be fixed.
       if (tablet_to_flush) {
-        LOG(INFO)
-            << LogPrefix(peer_to_flush)
-            << "Flushing tablet with oldest memstore write at "
-            << tablet_to_flush->OldestMutableMemtableWriteHybridTime();
+        if (to_flush.reason == MemstoreFlushReason::kOldestWrite) {
+          LOG(INFO)
+              << LogPrefix(peer_to_flush)
+              << "Flushing tablet with oldest memstore write at "
+              << tablet_to_flush->OldestMutableMemtableWriteHybridTime();
+        } else {
+          LOG(INFO)
+              << LogPrefix(peer_to_flush)
+              << "Flushing tablet, reason: " << to_flush.reason
+              << ", memtable size: " << HumanReadableNumBytes::ToString(to_flush.memtable_size)
+              << ", memtable age: " << to_flush.memtable_age
+              << ", score: " << to_flush.score;
+        }
         WARN_NOT_OK(
             tablet_to_flush->Flush(
                 tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs, flush_tick),
             Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
+        const auto& counter = flush_reason_counters_[to_underlying(to_flush.reason)];
+        if (counter) {
+          counter->Increment();
+        }
         for (auto listener : TEST_listeners) {
           listener->StartedFlush(peer_to_flush->tablet_id());
         }
@@ -312,28 +421,61 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
-// empty or about to flush.
-tablet::TabletPeerPtr TabletMemoryManager::TabletToFlush() {
+// Return the tablet to flush, or nullptr if all tablet memstores are empty or about to flush.
+TabletMemoryManager::TabletToFlushInfo TabletMemoryManager::TabletToFlush() {
+  const bool by_score = FLAGS_memstore_flush_by_score;
+  const auto min_bytes = FLAGS_memstore_flush_min_bytes;
   HybridTime oldest_write_in_memstores = HybridTime::kMax;
-  tablet::TabletPeerPtr tablet_to_flush;
+  TabletToFlushInfo result;
   for (const tablet::TabletPeerPtr& peer : peers_fn_()) {
     const auto tablet = peer->shared_tablet();
-    if (tablet) {
-      const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
-      if (ht.ok()) {
-        if (*ht < oldest_write_in_memstores) {
-          oldest_write_in_memstores = *ht;
-          tablet_to_flush = peer;
-        }
-      } else {
-        YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
-            "Failed to get oldest mutable memtable write ht for tablet $0: $1",
-            tablet->tablet_id(), ht.status());
+    if (!tablet) {
+      continue;
+    }
+    const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
+    if (!ht.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+          "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+          tablet->tablet_id(), ht.status());
+      continue;
+    }
+    if (*ht == HybridTime::kMax) {
+      continue;
+    }
+    if (!by_score) {
+      if (*ht < oldest_write_in_memstores) {
+        oldest_write_in_memstores = *ht;
+        result.peer = peer;
       }
+      continue;
+    }
+
+    TabletToFlushInfo candidate {
+      .peer = peer,
+      .memtable_size = tablet->GetMutableMemtablesSize(),
+      .memtable_age = MonoDelta::FromMicroseconds(std::max<int64_t>(
+          tablet->clock()->Now().GetPhysicalValueMicros() - ht->GetPhysicalValueMicros(), 0)),
+    };
+    candidate.score = FlushScore(candidate.memtable_size, candidate.memtable_age);
+    if (candidate.memtable_size < min_bytes) {
+      candidate.reason = MemstoreFlushReason::kSmallMemtable;
+    } else if (candidate.score >= 2 * candidate.memtable_size) {
+      candidate.reason = MemstoreFlushReason::kMemtableAge;
+    } else {
+      candidate.reason = MemstoreFlushReason::kMemtableSize;
+    }
+
+    // Small memtables are only flushed when there is no memtable of at least min_bytes.
+    const auto is_small = [](const TabletToFlushInfo& info) {
+      return info.reason == MemstoreFlushReason::kSmallMemtable;
+    };
+    if (!result.peer ||
+        std::make_pair(!is_small(candidate), candidate.score) >
+            std::make_pair(!is_small(result), result.score)) {
+      result = std::move(candidate);
     }
   }
-  return tablet_to_flush;
+  return result;
 }
 
 std::string TabletMemoryManager::LogPrefix(const tablet::TabletPeerPtr& peer) const {
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include <boost/optional.hpp>
@@ -20,17 +21,37 @@
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/util/background_task.h"
+#include "yb/util/enums.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/monotime.h"
 
 namespace yb {
 namespace tserver {
 
+// Reason why a tablet was selected for a flush when the global memstore limit was reached.
+YB_DEFINE_ENUM(MemstoreFlushReason,
+               // The tablet has the oldest memtable write, memstore_flush_by_score is off.
+               (kOldestWrite)
+               // The tablet has the highest score, mostly because of the size of its memtable.
+               (kMemtableSize)
+               // The tablet has the highest score, mostly because of the age of its memtable.
+               (kMemtableAge)
+               // No memtable reached memstore_flush_min_bytes, the one with the highest score
+               // was flushed.
+               (kSmallMemtable));
+
 class TabletMemoryManagerListenerIf {
  public:
   virtual ~TabletMemoryManagerListenerIf() {}
   virtual void StartedFlush(const TabletId& tablet_id) {}
 };
 
+// Returns the number of shard bits for a block cache of the specified size. Unless
+// db_block_cache_num_shard_bits is set, the number of shards grows with the number of cpus, limited
+// to [16, 1024] shards, and is reduced to keep shards at least 32MB when possible.
+int BlockCacheNumShardBits(int64_t block_cache_size_bytes, int num_cpus);
+
 // TabletMemoryManager keeps track of memory management for a tablet, including:
 // - Block cache initialization and tracking
 // - Log cache garbage collection
@@ -49,7 +70,7 @@ class TabletMemoryManager {
       const scoped_refptr<MetricEntity>& metrics,
       const std::function<std::vector<tablet::TabletPeerPtr>()>& peers_fn);
 
-  ~TabletMemoryManager() = default;
+  ~TabletMemoryManager();
 
   // Init and Shutdown start/stop the background memstore management task.
   Status Init();
@@ -82,9 +103,19 @@ class TabletMemoryManager {
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
-  // Determines which tablet has the oldest mutable memtable write time.  May return a null ptr
-  // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
-  tablet::TabletPeerPtr TabletToFlush();
+  struct TabletToFlushInfo {
+    tablet::TabletPeerPtr peer;
+    MemstoreFlushReason reason = MemstoreFlushReason::kOldestWrite;
+    uint64_t memtable_size = 0;
+    MonoDelta memtable_age;
+    double score = 0;
+  };
+
+  // Determines which tablet to flush. With memstore_flush_by_score, it is the tablet with the
+  // highest flush score, see FlushScore in the .cc file. Otherwise it is the tablet with the
+  // oldest mutable memtable write time. The peer is null if all memtables are empty or about to
+  // flush. Uses peers_fn_ to determine the full list of peers to check.
+  TabletToFlushInfo TabletToFlush();
 
   // Function to return a log prefix with the tablet's tablet_id and permanent_uuid.
   std::string LogPrefix(const tablet::TabletPeerPtr& peer) const;
@@ -103,6 +134,9 @@ class TabletMemoryManager {
   std::unique_ptr<BackgroundTask> background_task_;
 
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor_;
+
+  // Number of flushes started because of the global memstore limit, by reason.
+  std::array<scoped_refptr<Counter>, kMemstoreFlushReasonMapSize> flush_reason_counters_;
 };
 
 }  // namespace tserver
@@ -66,6 +66,7 @@
 #include "yb/tserver/tablet_memory_manager.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/tserver/tserver_service.service.h"
 
 #include "yb/util/format.h"
 #include "yb/util/test_util.h"
@@ -80,6 +81,9 @@ using std::string;
 
 DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
 DECLARE_bool(TEST_tserver_disable_heartbeat);
+DECLARE_int32(compaction_rate_limit_adjust_interval_ms);
+DECLARE_int64(compaction_rate_limit_min_bytes_per_sec);
+DECLARE_uint64(compaction_rate_limit_read_latency_target_us);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
 DECLARE_bool(disable_auto_flags_management);
@@ -694,6 +698,47 @@ TEST_F(TsTabletManagerTest, RateLimiterSharing) {
   peers_num = peers.size();
 }
 
+TEST_F(TsTabletManagerTest, AdaptiveCompactionRateLimit) {
+  constexpr auto kBPS = 128_MB;
+  constexpr auto kMinBPS = 16_MB;
+  constexpr uint64_t kTargetUs = 1000;
+  SetRateLimiterSharingMode(RateLimiterSharingMode::TSERVER);
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec) = kBPS;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_rate_limit_min_bytes_per_sec) = kMinBPS;
+  // Adjust the rate limit manually.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_rate_limit_adjust_interval_ms) = 0;
+  ASSERT_NO_FATAL_FAILURE(Reload());
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_rate_limit_read_latency_target_us) = kTargetUs;
+
+  auto reads = mini_server_->server()->GetMetricsHistogram(
+      TabletServerServiceRpcMethodIndexes::kRead);
+  ASSERT_NE(reads, nullptr);
+
+  // No reads: the configured rate limit is kept.
+  tablet_manager_->AdjustCompactionRateLimit();
+  ASSERT_EQ(kBPS, tablet_manager_->TEST_compaction_rate_limit());
+
+  // Slow reads: the rate limit is halved on every tick, down to the minimum.
+  int64_t expected = kBPS;
+  for (int i = 0; i != 5; ++i) {
+    reads->Increment(kTargetUs * 10);
+    tablet_manager_->AdjustCompactionRateLimit();
+    expected = std::max<int64_t>(expected / 2, kMinBPS);
+    ASSERT_EQ(expected, tablet_manager_->TEST_compaction_rate_limit());
+  }
+  ASSERT_EQ(kMinBPS, tablet_manager_->TEST_compaction_rate_limit());
+
+  // Fast reads: the rate limit grows by a tenth of the configured one.
+  reads->Increment(kTargetUs / 10);
+  tablet_manager_->AdjustCompactionRateLimit();
+  ASSERT_EQ(kMinBPS + kBPS / 10, tablet_manager_->TEST_compaction_rate_limit());
+
+  // The adaptation is turned off: the configured rate limit is restored.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_rate_limit_read_latency_target_us) = 0;
+  tablet_manager_->AdjustCompactionRateLimit();
+  ASSERT_EQ(0, tablet_manager_->TEST_compaction_rate_limit());
+}
+
 TEST_F(TsTabletManagerTest, DataAndWalFilesLocations) {
   std::string wal;
   std::string data;
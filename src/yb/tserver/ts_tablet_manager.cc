@@ -94,6 +94,7 @@
 #include "yb/tserver/remote_bootstrap_session.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tserver.pb.h"
+#include "yb/tserver/tserver_service.service.h"
 
 #include "yb/util/debug/long_operation_tracker.h"
 #include "yb/util/debug/trace_event.h"
@@ -102,6 +103,7 @@
 #include "yb/util/fault_injection.h"
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
@@ -203,6 +205,22 @@ DEFINE_UNKNOWN_int32(cleanup_metrics_interval_sec, 60,
              "The tick interval time for the metrics cleanup background task. "
              "If set to 0, it disables the background task.");
 
+DEFINE_NON_RUNTIME_int32(compaction_rate_limit_adjust_interval_ms, 1000,
+    "The tick interval time for adapting the tablet server wide flush and compaction rate limit "
+    "to the latency of reads. See compaction_rate_limit_read_latency_target_us. If set to 0, it "
+    "disables the background task.");
+
+DEFINE_RUNTIME_uint64(compaction_rate_limit_read_latency_target_us, 0,
+    "The target for the average latency of reads handled by this tablet server. When reads over "
+    "the last compaction_rate_limit_adjust_interval_ms are slower, the flush and compaction rate "
+    "limit is halved, down to compaction_rate_limit_min_bytes_per_sec. Otherwise it is raised by "
+    "a tenth of rocksdb_compact_flush_rate_limit_bytes_per_sec, up to that value. Only applies "
+    "when the rate limiter is shared by the tablet server. 0 disables the adaptation.");
+
+DEFINE_RUNTIME_int64(compaction_rate_limit_min_bytes_per_sec, 32_MB,
+    "The lowest flush and compaction rate limit set because of slow reads. See "
+    "compaction_rate_limit_read_latency_target_us.");
+
 DEFINE_UNKNOWN_int32(send_wait_for_report_interval_ms, 60000,
              "The tick interval time to trigger updating all transaction coordinators with wait-for"
              " relationships.");
@@ -248,6 +266,7 @@ DEFINE_UNKNOWN_bool(enable_restart_transaction_status_tablets_first, true,
 
 DECLARE_bool(enable_wait_queues);
 
+DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
 
 namespace yb {
@@ -377,6 +396,49 @@ void TSTabletManager::CleanupOldMetrics() {
   metric_registry_->RetireOldMetrics();
 }
 
+void TSTabletManager::AdjustCompactionRateLimit() {
+  const auto& rate_limiter = tablet_options_.rate_limiter;
+  const auto max_rate = FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec;
+  auto reads = server_->GetMetricsHistogram(TabletServerServiceRpcMethodIndexes::kRead);
+  if (!rate_limiter || max_rate <= 0 || !reads) {
+    return;
+  }
+
+  const auto read_count = reads->TotalCount();
+  const auto read_latency_sum_us = reads->histogram()->TotalSum();
+  const auto num_reads = read_count - prev_read_count_;
+  const auto latency_sum_us = read_latency_sum_us - prev_read_latency_sum_us_;
+  prev_read_count_ = read_count;
+  prev_read_latency_sum_us_ = read_latency_sum_us;
+
+  const auto target_us = FLAGS_compaction_rate_limit_read_latency_target_us;
+  if (target_us == 0) {
+    // Restore the configured rate after the adaptation was turned off.
+    if (compaction_rate_limit_ != 0) {
+      LOG_WITH_PREFIX(INFO) << "Restoring flush and compaction rate limit to " << max_rate;
+      rate_limiter->SetBytesPerSecond(max_rate);
+      compaction_rate_limit_ = 0;
+    }
+    return;
+  }
+
+  const auto min_rate = std::clamp<int64_t>(
+      FLAGS_compaction_rate_limit_min_bytes_per_sec, 1, max_rate);
+  const auto current_rate = compaction_rate_limit_ != 0 ? compaction_rate_limit_ : max_rate;
+  const bool slow_reads = num_reads > 0 && latency_sum_us > target_us * num_reads;
+  // Back off quickly when reads are slow and recover slowly, so compactions catch up during idle
+  // periods without causing latency spikes right after a busy period.
+  const auto new_rate = std::clamp<int64_t>(
+      slow_reads ? current_rate / 2 : current_rate + max_rate / 10, min_rate, max_rate);
+  if (new_rate != current_rate || compaction_rate_limit_ == 0) {
+    VLOG_WITH_PREFIX(1)
+        << "Changing flush and compaction rate limit from " << current_rate << " to "
+        << new_rate << ", reads: " << num_reads << ", total latency us: " << latency_sum_us;
+    rate_limiter->SetBytesPerSecond(new_rate);
+  }
+  compaction_rate_limit_ = new_rate;
+}
+
 void TSTabletManager::PollWaitingTxnRegistry() {
   DCHECK_NOTNULL(waiting_txn_registry_)->SendWaitForGraph();
 }
@@ -598,6 +660,9 @@ Status TSTabletManager::Init() {
   waiting_txn_registry_poller_ = std::make_unique<rpc::Poller>(
       LogPrefix(), std::bind(&TSTabletManager::PollWaitingTxnRegistry, this));
 
+  compaction_rate_limit_adjuster_ = std::make_unique<rpc::Poller>(
+      LogPrefix(), std::bind(&TSTabletManager::AdjustCompactionRateLimit, this));
+
   return Status::OK();
 }
 
@@ -674,6 +739,11 @@ Status TSTabletManager::Start() {
         &server_->messenger()->scheduler(), FLAGS_send_wait_for_report_interval_ms * 1ms);
   }
 
+  if (tablet_options_.rate_limiter && FLAGS_compaction_rate_limit_adjust_interval_ms > 0) {
+    compaction_rate_limit_adjuster_->Start(
+        &server_->messenger()->scheduler(), FLAGS_compaction_rate_limit_adjust_interval_ms * 1ms);
+  }
+
   return Status::OK();
 }
 
@@ -1701,6 +1771,8 @@ void TSTabletManager::StartShutdown() {
 
   waiting_txn_registry_poller_->Shutdown();
 
+  compaction_rate_limit_adjuster_->Shutdown();
+
   mem_manager_->Shutdown();
 
   // Wait for all RBS operations to finish.
@@ -356,6 +356,13 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Background task that Retires old metrics.
   void CleanupOldMetrics();
 
+  // Background task that adapts the rate limit of the RocksDB rate limiter shared by all tablets
+  // to the latency of reads.
+  void AdjustCompactionRateLimit();
+
+  // Returns the rate limit set by AdjustCompactionRateLimit, or 0 if the configured one is used.
+  int64_t TEST_compaction_rate_limit() const { return compaction_rate_limit_; }
+
   client::YBClient& client();
 
   const std::shared_future<client::YBClient*>& client_future();
@@ -634,6 +641,16 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unique_ptr<rpc::Poller> waiting_txn_registry_poller_;
 
+  // Used for adapting the shared flush and compaction rate limit to the latency of reads.
+  std::unique_ptr<rpc::Poller> compaction_rate_limit_adjuster_;
+
+  // Number and total latency of reads seen by the previous AdjustCompactionRateLimit call.
+  uint64_t prev_read_count_ = 0;
+  uint64_t prev_read_latency_sum_us_ = 0;
+
+  // Rate limit set by AdjustCompactionRateLimit, 0 while the configured limit is used.
+  int64_t compaction_rate_limit_ = 0;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -21,6 +21,7 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/xcluster_consumer.h"
@@ -73,6 +74,13 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool should_add_replication_status =
       FLAGS_tserver_heartbeat_metrics_add_replication_status && no_full_tablet_report;
 
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
+  auto ops_per_sec = [div](uint64_t ops, uint64_t prev_ops) {
+    return div > 0 && ops > prev_ops ? static_cast<double>(ops - prev_ops) / div : 0;
+  };
+
+  decltype(prev_tablet_ops_) tablet_ops;
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
@@ -81,6 +89,16 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
         total_file_sizes += sizes.first;
         uncompressed_file_sizes += sizes.second;
         num_files += tablet->GetCurrentVersionNumSSTFiles();
+        auto* tablet_metrics = tablet->metrics();
+        std::pair<uint64_t, uint64_t> ops(0, 0);
+        if (tablet_metrics) {
+          ops = {tablet_metrics->ql_read_latency->TotalCount(),
+                 tablet_metrics->ql_write_latency->TotalCount()};
+          tablet_ops.emplace(tablet_peer->tablet_id(), ops);
+        }
+        // A tablet that was not seen by the previous run has no rate yet.
+        auto prev_ops_it = prev_tablet_ops_.find(tablet_peer->tablet_id());
+        auto prev_ops = prev_ops_it != prev_tablet_ops_.end() ? prev_ops_it->second : ops;
         if (should_add_tablet_data && tablet_peer->log_available() &&
             tablet_peer->tablet_metadata()->tablet_data_state() ==
               tablet::TabletDataState::TABLET_DATA_READY) {
@@ -91,6 +109,8 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
           tablet_metadata->set_uncompressed_sst_file_size(sizes.second);
           tablet_metadata->set_may_have_orphaned_post_split_data(
                 tablet->MayHaveOrphanedPostSplitData());
+          tablet_metadata->set_read_ops_per_sec(ops_per_sec(ops.first, prev_ops.first));
+          tablet_metadata->set_write_ops_per_sec(ops_per_sec(ops.second, prev_ops.second));
         }
       }
     }
@@ -138,6 +158,7 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
+  prev_tablet_ops_ = std::move(tablet_ops);
 
   // Get the total number of read and write operations.
   auto reads_hist = server().GetMetricsHistogram(
@@ -149,9 +170,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
   // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
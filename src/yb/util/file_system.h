@@ -180,6 +180,11 @@ class RandomAccessFile : public FileWithUniqueId {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Asks the platform to start loading the given range of the file in background, so the following
+  // Read of this range does not block on the disk. Does not wait for the data and is just a hint,
+  // so implementations are free to ignore it.
+  virtual void Readahead(uint64_t offset, size_t n) {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -388,6 +393,8 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void Hint(AccessPattern pattern) override { return target_->Hint(pattern); }
 
+  void Readahead(uint64_t offset, size_t n) override { target_->Readahead(offset, n); }
+
   Status InvalidateCache(size_t offset, size_t length) override;
 
  private:
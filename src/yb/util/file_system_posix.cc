@@ -257,6 +257,15 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Readahead(uint64_t offset, size_t n) {
+  // Readahead only populates OS page cache, so it does not make sense when it is not used.
+  if (!use_os_buffer_) {
+    return;
+  }
+  // POSIX_FADV_WILLNEED initiates asynchronous read of the range into the page cache.
+  Fadvise(fd_, static_cast<off_t>(offset), n, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();